@@ -1,39 +1,55 @@
 // Skeleton code for hw2a
 // Based on example code from: Interactive Computer Graphics: A Top-Down Approach with Shader-Based OpenGL (6th Edition), by Ed Angel
 
+#include <cctype>
 #include <cstdlib>
 #include <cstdio>
+#include <cstring>
 #include <cmath>
 #include <iostream>
+#include <optional>
 #include <sstream>
 
 #include "glad/glad.h"
 #include "GLFW/glfw3.h"
 
 #define DEBUG_ON 0  // repetitive of the debug flag in the shader loading code, included here for clarity only
+#define AFFINE_MATRIX_ON 1  // upload the model transform as a 6-float mat3x2 instead of a 16-float mat4
 
 // This file contains the code that reads the shaders from their files and compiles them
+#include "core/AffineMatrix.hpp"
+#include "core/FramePacer.hpp"
+#include "core/IndexedMesh.hpp"
+#include "core/InputAccumulator.hpp"
 #include "core/Matrix.hpp"
+#include "core/MeshFile.hpp"
+#include "core/MeshLOD.hpp"
+#include "core/MeshOptimizer.hpp"
+#include "core/CurveTessellator.hpp"
+#include "core/Model.hpp"
+#include "core/VertexFormat.hpp"
 #include "ShaderStuff.hpp"
+#include "HeadlessContext.hpp"
+#include "InstanceSet.hpp"
+#include "OffscreenFramebuffer.hpp"
+#include "PolygonShape.hpp"
 
 //----------------------------------------------------------------------------
 
-// initialize some basic structure types
-struct FloatType2D {
-    GLfloat x;
-	GLfloat y;
-};
-
-struct ColorType3D {
-    GLfloat r;
-	GLfloat g;
-	GLfloat b;
-};
-
-// General transformation matrix
-GLmatrix M;
+// General transformation matrix (built at compile time)
+#if AFFINE_MATRIX_ON
+using ModelMatrix = GLaffineMatrix;
+#else
+using ModelMatrix = GLmatrix;
+#endif
+constinit ModelMatrix M;
 GLint gUniformMatrixLocation = -1;
 
+// The model is drawn by its own program when it is instanced (see InstanceSet.hpp), the shapes never are
+GLuint gProgram = 0;
+GLuint gModelProgram = 0;
+GLint gModelMatrixLocation = -1;
+
 // Input Globals
 enum MouseMode {
 	NO_MODE = 0,
@@ -42,6 +58,12 @@ enum MouseMode {
 };
 MouseMode gCurrentMode = NO_MODE;
 
+// Transform changes from input events, applied to M once per frame
+InputAccumulator<GLfloat> gInput;
+size_t gInputEventCount = 0;
+size_t gInputUpdateCount = 0;
+double gFirstInputTime = -1; // when the oldest input not yet on screen arrived, -1 if none
+
 GLdouble gPreviousMouseX = 0.0, gPreviousMouseY = 0.0;
 
 // Window Globals
@@ -56,9 +78,53 @@ const float	kScaleDecrement = -0.05;
 // Some different cursors
 GLFWcursor *arrow_cursor = nullptr, *crosshair_cursor = nullptr, *move_cursor = nullptr;
 
-const GLint NVERTICES = 9; // part of the hard-coded model
+// Redraw Globals: a frame is drawn only when something invalidated the last one
+bool gSceneInvalid = true;
+size_t gDrawnFrames = 0;
+size_t gSkippedFrames = 0; // wakeups with nothing new to draw
+
+// Vertex buffer layout for text models: interleaved positions and RGBA8 colors, 12 bytes per vertex
+constexpr VertexFormat kVertexFormat = VertexFormat::Packed();
+
+// Triangle and vertex reordering applied to text models before upload. Triangles keep
+// their file order unless --vertex-cache or --morton asks otherwise: there is no depth
+// test, so where triangles overlap their order decides which one is seen.
+MeshOptimizer::Options gMeshOptimizerOptions = {MeshOptimizer::TriangleOrder::kSource, true};
+
+GLsizei gVertexCount = 0; // number of vertices in the model being drawn
+GLsizei gIndexCount = 0;  // number of indices, 0 when the model is drawn without an index buffer
+GLenum gIndexType = GL_UNSIGNED_INT;
+GLuint gModelVertexArray = 0;
+
+// Ranges of the index buffer, the full model first, then coarser ones; see drawModel().
+// Mesh files bring the levels the converter built; text models only get them with --lod.
+std::vector<MeshLOD::Level> gModelLevels;
+bool gBuildModelLevels = false;
+
+// Attribute locations in the shader program, shared by the model and the shapes
+GLint gPositionLocation = -1;
+GLint gColorLocation = -1;
 
 
+//----------------------------------------------------------------------------
+// marks the frame on screen out of date; input, resizes and new data call this
+static void
+invalidateScene()
+{
+	gSceneInvalid = true;
+}
+
+//----------------------------------------------------------------------------
+// invalidates the scene for input that changed the transform, noting when the frame's first such input came
+static void
+inputChanged()
+{
+	if (gFirstInputTime < 0)
+		gFirstInputTime = glfwGetTime();
+
+	invalidateScene();
+}
+
 //----------------------------------------------------------------------------
 // function that is called whenever an error occurs
 static void
@@ -86,31 +152,36 @@ key_callback(GLFWwindow* window, int key, int scancode, int action, int mods)
 
 		case GLFW_KEY_LEFT:
 		{
-			M.ScaleXBy(kScaleDecrement);
+			gInput.ScaleXBy(kScaleDecrement);
+			inputChanged();
 			break;
 		}
 
 		case GLFW_KEY_RIGHT:
 		{
-			M.ScaleXBy(kScaleIncrement);
+			gInput.ScaleXBy(kScaleIncrement);
+			inputChanged();
 			break;
 		}
 
 		case GLFW_KEY_UP:
 		{
-			M.ScaleYBy(kScaleIncrement);
+			gInput.ScaleYBy(kScaleIncrement);
+			inputChanged();
 			break;
 		}
 
 		case GLFW_KEY_DOWN:
 		{
-			M.ScaleYBy(kScaleDecrement);
+			gInput.ScaleYBy(kScaleDecrement);
+			inputChanged();
 			break;
 		}
 
 		case GLFW_KEY_R:
 		{
-			M.Reset();
+			gInput.Reset();
+			inputChanged();
 			break;
 		}
 
@@ -158,12 +229,16 @@ cursor_pos_callback(GLFWwindow* window, double xpos, double ypos)
 
 	double mouseXDelta = gPreviousMouseX - scaledXPos;
 	double mouseYDelta = gPreviousMouseY - scaledYPos;
+	if (mouseXDelta == 0 && mouseYDelta == 0)
+		return; // e.g. the cursor sampled again when input is latched, see latchInput()
 	if (gCurrentMode == ROTATE_MODE) {
 		static constexpr double piFraction = (2 * std::numbers::pi);
-		M.Rotate2DBy(static_cast<float>(piFraction) * static_cast<float>(mouseXDelta));
+		gInput.Rotate2DBy(static_cast<float>(piFraction) * static_cast<float>(mouseXDelta));
+		inputChanged();
 	} else if (gCurrentMode == TRANSLATE_MODE) {
-		M.TranslateXBy(static_cast<float>(mouseXDelta));
-		M.TranslateYBy(static_cast<float>(mouseYDelta));
+		gInput.TranslateXBy(static_cast<float>(mouseXDelta));
+		gInput.TranslateYBy(static_cast<float>(mouseYDelta));
+		inputChanged();
 	}
 
 	gPreviousMouseX = scaledXPos;
@@ -171,16 +246,46 @@ cursor_pos_callback(GLFWwindow* window, double xpos, double ypos)
 }
 
 //----------------------------------------------------------------------------
+// function that is called whenever the window is resized, in screen coordinates
+static void
+window_size_callback(GLFWwindow* window, int width, int height)
+{
+	window_width = width;
+	window_height = height;
+	invalidateScene();
+}
 
-void
-init()
+//----------------------------------------------------------------------------
+// function that is called whenever the window's framebuffer is resized, in pixels
+static void
+framebuffer_size_callback(GLFWwindow* window, int width, int height)
+{
+	glViewport(0, 0, width, height);
+	invalidateScene();
+}
+
+//----------------------------------------------------------------------------
+// function that is called whenever the window system needs the window's contents redrawn
+static void
+window_refresh_callback(GLFWwindow* window)
 {
-    ColorType3D colors[NVERTICES];
-    FloatType2D vertices[NVERTICES];
-    GLuint vao[1], buffer, program, location1, location2;
-  
+	invalidateScene();
+}
+
+//----------------------------------------------------------------------------
+
+// the model drawn when no model file is given on the command line
+static void
+makeDefaultModel(Model& model)
+{
+    const size_t NVERTICES = 9;
+    model.vertices.resize(NVERTICES);
+    model.colors.resize(NVERTICES);
+
+    std::vector<ColorType3D>& colors = model.colors;
+    std::vector<FloatType2D>& vertices = model.vertices;
+
     // set up some hard-coded colors and geometry
-    // this part can be customized to read in an object description from a file
     colors[0].r = 1;  colors[0].g = 1;  colors[0].b = 1;  // white
     colors[1].r = 1;  colors[1].g = 0;  colors[1].b = 0;  // red
     colors[2].r = 1;  colors[2].g = 0;  colors[2].b = 0;  // red
@@ -200,34 +305,178 @@ init()
     vertices[6].x =  0;     vertices[6].y =  0.25; // center (again)
     vertices[7].x = -0.5;   vertices[7].y = -0.25; // low-lower left
     vertices[8].x = -0.25;  vertices[8].y = -0.5; // mid-lower left
-    
+}
+
+// Lays 'count' copies of the model out on a grid over the window, each turned
+// and tinted differently
+static void
+makeInstanceGrid(size_t count, std::vector<GLaffineMatrix>& transforms, std::vector<ColorType3D>& tints)
+{
+	const size_t columns = static_cast<size_t>(std::ceil(std::sqrt(static_cast<double>(count))));
+	const float cellSize = 2.f / static_cast<float>(columns);
+	constexpr float kGoldenAngle = 2.39996323f;
+
+	transforms.resize(count);
+	tints.resize(count);
+	for (size_t instance = 0; instance < count; instance++) {
+		const float angle = kGoldenAngle * static_cast<float>(instance);
+		const float x = -1.f + (cellSize * (static_cast<float>(instance % columns) + 0.5f));
+		const float y = 1.f - (cellSize * (static_cast<float>(instance / columns) + 0.5f));
+
+		// The default model spans about a unit; keep each copy inside its cell
+		transforms[instance].SetTransforms({cellSize * 0.8f, cellSize * 0.8f, angle, x, y});
+		tints[instance] = {0.6f + (0.4f * std::cos(angle)), 0.6f + (0.4f * std::cos(angle + 2.1f)),
+			0.6f + (0.4f * std::cos(angle + 4.2f))};
+	}
+}
+
+//----------------------------------------------------------------------------
+
+// Creates the vertex array object and the buffer the model is drawn from
+static void
+createVertexArray()
+{
+    GLuint vao[1], buffer;
+
     // Create and bind a vertex array object
     glGenVertexArrays(1, vao);
     glBindVertexArray(vao[0]);
+    gModelVertexArray = vao[0];
 
-    // Create and initialize a buffer object large enough to hold both vertex position and color data
     glGenBuffers(1, &buffer );
     glBindBuffer(GL_ARRAY_BUFFER, buffer);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices) + sizeof(colors), vertices, GL_STATIC_DRAW);
-    glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices);
-    glBufferSubData(GL_ARRAY_BUFFER, sizeof(vertices), sizeof(colors), colors);
-    
+}
+
+// Creates the index buffer, which the bound vertex array object records
+static void
+uploadIndices(GLsizei count, GLenum type, GLsizeiptr size, const void* data)
+{
+    GLuint indexBuffer;
+    glGenBuffers(1, &indexBuffer);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, size, data, GL_STATIC_DRAW);
+
+    gIndexCount = count;
+    gIndexType = type;
+    gModelLevels = {{0, static_cast<uint32_t>(count), 0}};
+}
+
+// Uploads a text (or built-in) model as unique vertices in kVertexFormat, plus indices
+static std::vector<MeshFile::AttributeDescriptor>
+uploadModel(const Model& model)
+{
+    IndexedMesh mesh = BuildIndexedMesh(model);
+    mesh.PrintReduction("indexed model", kVertexFormat.VertexSize());
+
+    MeshOptimizer::PrintStatistics("before optimizing", MeshOptimizer::Analyze(mesh, kVertexFormat.VertexSize()));
+    MeshOptimizer::Optimize(mesh, gMeshOptimizerOptions);
+    MeshOptimizer::PrintStatistics("after optimizing", MeshOptimizer::Analyze(mesh, kVertexFormat.VertexSize()));
+
+    // Coarser levels go after the full one in the same index buffer
+    std::vector<MeshLOD::Level> levels;
+    if (gBuildModelLevels) {
+        levels = MeshLOD::BuildLevels(mesh, gMeshOptimizerOptions);
+        MeshLOD::PrintLevels("model", levels);
+    }
+
+    createVertexArray();
+
+    // The buffer is sized from the unique vertices
+    gVertexCount = static_cast<GLsizei>(mesh.vertices.VertexCount());
+
+    // Initialize the buffer object with both vertex position and color data
+    const std::vector<std::byte> vertexData = kVertexFormat.Pack(mesh.vertices);
+    glBufferData(GL_ARRAY_BUFFER, vertexData.size(), vertexData.data(), GL_STATIC_DRAW);
+
+    const std::vector<std::byte> indexData = mesh.PackIndices();
+    uploadIndices(static_cast<GLsizei>(mesh.indices.size()), mesh.IndexType(), indexData.size(), indexData.data());
+    if (!levels.empty())
+        gModelLevels = std::move(levels);
+
+    return kVertexFormat.Attributes(mesh.vertices.VertexCount());
+}
+
+// Uploads a mapped mesh file: its blobs go to the driver straight from the mapping
+static std::vector<MeshFile::AttributeDescriptor>
+uploadMesh(const MeshFile::MappedMesh& mesh)
+{
+    createVertexArray();
+
+    const MeshFile::Header& header = mesh.GetHeader();
+    gVertexCount = static_cast<GLsizei>(header.vertexCount);
+    gIndexCount = 0;
+
+    glBufferData(GL_ARRAY_BUFFER, header.vertexDataSize, mesh.VertexData(), GL_STATIC_DRAW);
+
+    if (header.indexCount > 0)
+        uploadIndices(static_cast<GLsizei>(header.indexCount), header.indexType, header.indexDataSize, mesh.IndexData());
+
+    // Levels of detail were built by the converter, if at all
+    if (!mesh.Levels().empty()) {
+        gModelLevels = MeshLOD::FromDescriptors(mesh.Levels());
+        MeshLOD::PrintLevels("mesh", gModelLevels);
+    }
+
+    const std::span<const MeshFile::AttributeDescriptor> attributes = mesh.Attributes();
+    return {attributes.begin(), attributes.end()};
+}
+
+//----------------------------------------------------------------------------
+
+void
+init(std::span<const MeshFile::AttributeDescriptor> attributes, bool instanced)
+{
+    GLuint program;
+
     // Define the names of the shader files
-    std::stringstream vshader, fshader;
+    std::stringstream vshader, vshaderInstanced, fshader;
+#if AFFINE_MATRIX_ON
+    vshader << SRC_DIR << "/vshader2a_affine.glsl";
+    vshaderInstanced << SRC_DIR << "/vshader2a_affine_instanced.glsl";
+#else
     vshader << SRC_DIR << "/vshader2a.glsl";
+    vshaderInstanced << SRC_DIR << "/vshader2a_instanced.glsl";
+#endif
     fshader << SRC_DIR << "/fshader2a.glsl";
     
     // Load the shaders and use the resulting shader program
     program = InitShader( vshader.str().c_str(), fshader.str().c_str() );
+    gProgram = program;
+    gModelProgram = program;
     
     // Determine locations of the necessary attributes and matrices used in the vertex shader
-    location1 = glGetAttribLocation( program, "vertex_position" );
-    glEnableVertexAttribArray( location1 );
-    glVertexAttribPointer( location1, 2, GL_FLOAT, GL_FALSE, 0, BUFFER_OFFSET(0) );
-    location2 = glGetAttribLocation( program, "vertex_color" );
-    glEnableVertexAttribArray( location2 );
-    glVertexAttribPointer( location2, 3, GL_FLOAT, GL_FALSE, 0, BUFFER_OFFSET(sizeof(vertices)) );
+    gPositionLocation = glGetAttribLocation( program, "vertex_position" );
+    gColorLocation = glGetAttribLocation( program, "vertex_color" );
 	gUniformMatrixLocation = glGetUniformLocation(program, "M");
+
+    // Instanced copies of the model read their transforms in a program of their own
+    if (instanced) {
+        gModelProgram = InitShader( vshaderInstanced.str().c_str(), fshader.str().c_str() );
+        InstanceSet::SetSamplers(gModelProgram);
+    }
+
+    gModelMatrixLocation = glGetUniformLocation(gModelProgram, "M");
+    const GLint modelPositionLocation = glGetAttribLocation( gModelProgram, "vertex_position" );
+    const GLint modelColorLocation = glGetAttribLocation( gModelProgram, "vertex_color" );
+    glBindVertexArray(gModelVertexArray);
+    for (const MeshFile::AttributeDescriptor& attribute : attributes) {
+        GLint location = -1;
+        switch (MeshFile::Semantic(attribute.semantic)) {
+            case MeshFile::Semantic::kPosition:
+                location = modelPositionLocation;
+                break;
+            case MeshFile::Semantic::kColor:
+                location = modelColorLocation;
+                break;
+        }
+
+        if (location < 0)
+            continue;
+
+        glEnableVertexAttribArray( location );
+        glVertexAttribPointer( location, attribute.componentCount, attribute.componentType, attribute.normalized,
+            attribute.stride, BUFFER_OFFSET(size_t(attribute.offset)) );
+    }
     
     // Define static OpenGL state variables
     glClearColor( 1.0, 1.0, 1.0, 1.0 ); // white, opaque background
@@ -244,12 +493,199 @@ init()
 
 //----------------------------------------------------------------------------
 
+// Holds the frame until 'pacer' says to latch input, still handling events
+// meanwhile, then samples the cursor where it is now
+static double
+latchInput(GLFWwindow* window, const FramePacer& pacer)
+{
+	const double latchTime = pacer.LatchTime(glfwGetTime());
+	for (double now = glfwGetTime(); now < latchTime; now = glfwGetTime())
+		glfwWaitEventsTimeout(latchTime - now);
+
+	glfwPollEvents();
+
+	double cursorX, cursorY;
+	glfwGetCursorPos(window, &cursorX, &cursorY);
+	cursor_pos_callback(window, cursorX, cursorY);
+
+	return glfwGetTime();
+}
+
+//----------------------------------------------------------------------------
+
+// Pixels a model unit covers at most under M: NDC spans the window in 2 units
+static GLfloat
+pixelsPerUnit()
+{
+	return M.MaxScale() * static_cast<GLfloat>(std::max(window_width, window_height)) / 2;
+}
+
+// Sends M to the current program
+static void
+uploadMatrix(GLint location)
+{
+	// sanity check that your matrix contents are what you expect them to be
+#if AFFINE_MATRIX_ON
+	if (DEBUG_ON)
+		printf("M = [%f %f %f\n     %f %f %f]\n",M[0],M[2],M[4], M[1],M[3],M[5]);
+
+	glUniformMatrix3x2fv(location, 1, GL_FALSE, M );   // send the updated model transformation matrix to the GPU
+#else
+	if (DEBUG_ON)
+		printf("M = [%f %f %f %f\n     %f %f %f %f\n     %f %f %f %f\n     %f %f %f %f]\n",M[0],M[4],M[8],M[12], M[1],M[5],M[9],M[13], M[2],M[6],M[10],M[14], M[3],M[7],M[11],M[15]);
+
+	glUniformMatrix4fv(location, 1, GL_FALSE, M );   // send the updated model transformation matrix to the GPU
+#endif
+}
+
+// Draws the model, or every copy in 'instances' with one call, at the
+// coarsest level of detail that looks the same at the current scale
+static void
+drawModel(const InstanceSet* instances)
+{
+	glUseProgram(gModelProgram);
+	uploadMatrix(gModelMatrixLocation);
+
+	const GLsizei instanceCount = (instances != nullptr) ? instances->Count() : 1;
+	if (instances != nullptr)
+		instances->Bind();
+
+	glBindVertexArray(gModelVertexArray);
+	if (gIndexCount == 0) {
+		glDrawArraysInstanced( GL_TRIANGLES, 0, gVertexCount, instanceCount );    // draw a triangle between the first vertex and each successive vertex pair in the model
+		return;
+	}
+
+	// Copies are as large as the largest of them
+	const GLfloat pixelScale = pixelsPerUnit() * ((instances != nullptr) ? instances->MaxScale() : 1.f);
+
+	const size_t level = MeshLOD::SelectLevel(gModelLevels, pixelScale);
+	if (DEBUG_ON)
+		printf("drawing level %zu: %u triangles\n", level, gModelLevels[level].indexCount / 3);
+
+	const size_t firstByte = gModelLevels[level].firstIndex * MeshFile::IndexSize(gIndexType);
+	glDrawElementsInstanced( GL_TRIANGLES, gModelLevels[level].indexCount, gIndexType, BUFFER_OFFSET(firstByte), instanceCount );    // draw a triangle for each successive index triple
+}
+
+// Draws the shapes, first re-flattening any curved outline whose zoom level changed
+static void
+drawShapes(std::vector<PolygonShape>& shapes, std::vector<TessellatedPolygon<GLfloat>>& outlines)
+{
+	if (gModelProgram != gProgram) {
+		glUseProgram(gProgram);
+		uploadMatrix(gUniformMatrixLocation);
+	}
+
+	const GLfloat pixelScale = pixelsPerUnit();
+
+	for (size_t shape = 0; shape < shapes.size(); shape++) {
+		if (outlines[shape].Update(pixelScale))
+			shapes[shape].SetPolygon(outlines[shape].Polygon());
+
+		shapes[shape].Draw();
+	}
+}
+
+// One frame of everything, into whatever framebuffer is bound
+static void
+drawScene(const InstanceSet* instances, std::vector<PolygonShape>& shapes, std::vector<TessellatedPolygon<GLfloat>>& outlines)
+{
+	// fill/re-fill the window with the background color
+	glClear(GL_COLOR_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
+
+	drawModel(instances);
+	drawShapes(shapes, outlines);
+}
+
+// Draws 'frameCount' frames into a framebuffer object of the window's size,
+// timing them, then saves the last one to 'outputPath' if there is one
+static bool
+renderHeadless(size_t frameCount, const char* outputPath, const InstanceSet* instances,
+	std::vector<PolygonShape>& shapes, std::vector<TessellatedPolygon<GLfloat>>& outlines)
+{
+	OffscreenFramebuffer framebuffer(window_width, window_height);
+	if (!framebuffer.IsComplete()) {
+		printf("can't render offscreen at %dx%d\n", window_width, window_height);
+		return false;
+	}
+
+	framebuffer.Bind();
+
+	// the first frame also pays for the driver's first-draw work and for buffer uploads
+	// (deferred by the driver, or the shapes' outlines), so it's timed alone
+	const double startTime = glfwGetTime();
+	drawScene(instances, shapes, outlines);
+	glFinish();
+	const double firstFrameTime = glfwGetTime();
+
+	for (size_t frame = 1; frame < frameCount; frame++)
+		drawScene(instances, shapes, outlines);
+	glFinish();	// the frames are only drawn once the GL says so
+	const double endTime = glfwGetTime();
+
+	printf("rendered %zu frames at %dx%d: first in %.2f ms", frameCount, window_width, window_height,
+		1000 * (firstFrameTime - startTime));
+	if (frameCount > 1)
+		printf(", the rest in %.3f ms each", 1000 * (endTime - firstFrameTime) / double(frameCount - 1));
+	printf("\n");
+
+	return outputPath == nullptr || framebuffer.WritePPM(outputPath);
+}
+
+//----------------------------------------------------------------------------
+
 int
 main(int argc, char* argv[])
 {
+	// Usage: HW2a [model] [--vertex-cache | --morton] [--lod] [--shapes shapes.txt] [--instances count] [--late-latch [deadline ms]]
+	//             [--headless [WIDTHxHEIGHT] [--frames count] [--output image.ppm]]
+	const char* modelPath = nullptr;
+	const char* shapesPath = nullptr;
+	size_t instanceCount = 0;
+	bool lateLatch = false;
+	double latchDeadline = FramePacer::kDefaultDeadline;
+	bool headless = false;
+	size_t frameCount = 1;
+	const char* outputPath = nullptr;
+	for (int argument = 1; argument < argc; argument++) {
+		if (strcmp(argv[argument], "--shapes") == 0 && argument + 1 < argc)
+			shapesPath = argv[++argument];
+		else if (strcmp(argv[argument], "--vertex-cache") == 0)
+			gMeshOptimizerOptions.triangleOrder = MeshOptimizer::TriangleOrder::kVertexCache;
+		else if (strcmp(argv[argument], "--morton") == 0)
+			gMeshOptimizerOptions.triangleOrder = MeshOptimizer::TriangleOrder::kMorton;
+		else if (strcmp(argv[argument], "--lod") == 0)
+			gBuildModelLevels = true;
+		else if (strcmp(argv[argument], "--instances") == 0 && argument + 1 < argc)
+			instanceCount = strtoul(argv[++argument], nullptr, 10);
+		else if (strcmp(argv[argument], "--late-latch") == 0) {
+			lateLatch = true;
+			if (argument + 1 < argc && (isdigit(argv[argument + 1][0]) || argv[argument + 1][0] == '.'))
+				latchDeadline = strtod(argv[++argument], nullptr) / 1000;
+		} else if (strcmp(argv[argument], "--headless") == 0) {
+			headless = true;
+			GLint width, height;
+			if (argument + 1 < argc && sscanf(argv[argument + 1], "%dx%d", &width, &height) == 2
+				&& width > 0 && height > 0) {
+				window_width = width;
+				window_height = height;
+				argument++;
+			}
+		} else if (strcmp(argv[argument], "--frames") == 0 && argument + 1 < argc)
+			frameCount = std::max(1ul, strtoul(argv[++argument], nullptr, 10));
+		else if (strcmp(argv[argument], "--output") == 0 && argument + 1 < argc)
+			outputPath = argv[++argument];
+		else
+			modelPath = argv[argument];
+	}
+
     // Define the error callback function
     glfwSetErrorCallback(error_callback);
-    
+
+	// Headless runs need no display server: GLFW's null platform renders through OSMesa
+	if (headless)
+		glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+
     // Initialize GLFW (performs platform-specific initialization)
     if (!glfwInit())
 		exit(EXIT_FAILURE);
@@ -259,57 +695,182 @@ main(int argc, char* argv[])
     glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 2);
     glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
     glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+    glfwWindowHint(GLFW_STENCIL_BITS, 8);  // used by stencil-filled shapes
+	if (headless) {
+		glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+		glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_OSMESA_CONTEXT_API);
+	}
 
     // Use GLFW to open a window within which to display your graphics
 	GLFWwindow* window = glfwCreateWindow(window_width, window_height, "HW2a", nullptr, nullptr);
+
+	// Without OSMesa, a headless run can still have a context with no surface at all
+	std::optional<HeadlessContext> headlessContext;
+	GLADloadproc procAddressLoader = (GLADloadproc)glfwGetProcAddress;
+	if (!window && headless) {
+		printf("no OSMesa context; trying a surfaceless EGL one\n");
+		if (headlessContext.emplace().Create(3, 2))
+			procAddressLoader = HeadlessContext::ProcAddressLoader();
+		else
+			headlessContext.reset();
+	}
 	
     // Verify that the window was successfully created; if not, print error message and terminate
-    if (!window)
+    if (!window && !headlessContext)
 	{
         printf("GLFW failed to create window; terminating\n");
         glfwTerminate();
         exit(EXIT_FAILURE);
 	}
     
-	glfwMakeContextCurrent(window); // makes the newly-created context current
+	if (window)
+		glfwMakeContextCurrent(window); // makes the newly-created context current
     
     // Load all OpenGL functions (needed if using Windows)
-    if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
+    if (!gladLoadGLLoader(procAddressLoader)) {
 		printf("gladLoadGLLoader failed; terminating\n");
 		glfwTerminate();
 		exit(EXIT_FAILURE);
 	}
     
-	glfwSwapInterval(1);  // tells the system to wait for the rendered frame to finish updating before swapping buffers; can help to avoid tearing
+	if (!headless) {
+		glfwSwapInterval(1);  // tells the system to wait for the rendered frame to finish updating before swapping buffers; can help to avoid tearing
+
+		// Define the keyboard callback function
+		glfwSetKeyCallback(window, key_callback);
+		// Define the mouse button callback function
+		glfwSetMouseButtonCallback(window, mouse_button_callback);
+		// Define the mouse motion callback function
+		glfwSetCursorPosCallback(window, cursor_pos_callback);
+		// Define the callbacks that invalidate the window's contents
+		glfwSetWindowSizeCallback(window, window_size_callback);
+		glfwSetFramebufferSizeCallback(window, framebuffer_size_callback);
+		glfwSetWindowRefreshCallback(window, window_refresh_callback);
+	}
 
-    // Define the keyboard callback function
-    glfwSetKeyCallback(window, key_callback);
-    // Define the mouse button callback function
-    glfwSetMouseButtonCallback(window, mouse_button_callback);
-    // Define the mouse motion callback function
-    glfwSetCursorPosCallback(window, cursor_pos_callback);
+	// Load the model named on the command line, or fall back to the hard-coded one.
+	// A binary mesh (.hw2m) is mapped, not parsed; the mapping is dropped once uploaded.
+	std::vector<MeshFile::AttributeDescriptor> attributes;
+	const size_t modelPathLength = (modelPath != nullptr) ? strlen(modelPath) : 0;
+	if (modelPathLength > 5 && strcmp(modelPath + modelPathLength - 5, ".hw2m") == 0) {
+		MeshFile::MappedMesh mesh;
+		if (!mesh.Open(modelPath)) {
+			glfwTerminate();
+			exit(EXIT_FAILURE);
+		}
+
+		attributes = uploadMesh(mesh);
+	} else {
+		Model model;
+		if (modelPath == nullptr)
+			makeDefaultModel(model);
+		else if (!LoadTextModelParallel(modelPath, model)) {
+			glfwTerminate();
+			exit(EXIT_FAILURE);
+		}
+
+		attributes = uploadModel(model);
+	}
 
 	// Create the shaders and perform other one-time initializations
-	init();
+	init(attributes, instanceCount > 0);
+
+	// Copies of the model drawn with one instanced call instead of the model itself
+	std::optional<InstanceSet> instances;
+	if (instanceCount > 0) {
+		std::vector<GLaffineMatrix> transforms;
+		std::vector<ColorType3D> tints;
+		makeInstanceGrid(instanceCount, transforms, tints);
+
+		if (!instances.emplace().Set(transforms, tints)) {
+			instances.reset();
+			glfwTerminate();
+			exit(EXIT_FAILURE);
+		}
+	}
+
+	// Polygons drawn over the model, each filled the way its file entry asks.
+	// Curved outlines are flattened for the current zoom, see drawShapes().
+	std::vector<PolygonShape> shapes;
+	std::vector<TessellatedPolygon<GLfloat>> outlines;
+	if (shapesPath != nullptr) {
+		std::vector<ShapeDescription> descriptions;
+		if (!LoadTextShapes(shapesPath, descriptions)) {
+			glfwTerminate();
+			exit(EXIT_FAILURE);
+		}
+
+		shapes.reserve(descriptions.size());
+		outlines.reserve(descriptions.size());
+		for (ShapeDescription& description : descriptions) {
+			PolygonShape& shape = shapes.emplace_back(gPositionLocation, gColorLocation);
+			shape.SetName("shape " + std::to_string(shapes.size()) + " of " + shapesPath);
+			shape.SetColor(description.color);
+			shape.SetFillMode(description.fillMode);
+			outlines.emplace_back(std::move(description.shape));
+		}
+	}
+
+	// Batch rendering: the same frames as the window's, drawn offscreen and timed
+	if (headless) {
+		const bool rendered = renderHeadless(frameCount, outputPath, instances ? &*instances : nullptr, shapes, outlines);
+
+		// Objects are released while their context still exists
+		shapes.clear();
+		instances.reset();
+		headlessContext.reset();
+		if (window)
+			glfwDestroyWindow(window);
+		glfwTerminate();
+		exit(rendered ? EXIT_SUCCESS : EXIT_FAILURE);
+	}
+
+	// Blanks are predicted from the monitor's refresh rate; latency is measured either way
+	const GLFWvidmode* videoMode = glfwGetVideoMode(glfwGetPrimaryMonitor());
+	FramePacer pacer((videoMode != nullptr) ? videoMode->refreshRate : FramePacer::kDefaultRefreshRate, latchDeadline);
+
+	// everything loaded so far still has to be drawn once
+	invalidateScene();
 
 	// event loop
     while (!glfwWindowShouldClose(window)) {
-        // fill/re-fill the window with the background color
-		glClear(GL_COLOR_BUFFER_BIT);
-        
-        // sanity check that your matrix contents are what you expect them to be
-        if (DEBUG_ON)
-			printf("M = [%f %f %f %f\n     %f %f %f %f\n     %f %f %f %f\n     %f %f %f %f]\n",M[0],M[4],M[8],M[12], M[1],M[5],M[9],M[13], M[2],M[6],M[10],M[14], M[3],M[7],M[11],M[15]);
-
-        glUniformMatrix4fv(gUniformMatrixLocation, 1, GL_FALSE, M );   // send the updated model transformation matrix to the GPU
-		glDrawArrays( GL_TRIANGLES, 0, NVERTICES );    // draw a triangle between the first vertex and each successive vertex pair in the hard-coded model
-		glFlush();	// ensure that all OpenGL calls have executed before swapping buffers
-
-        glfwSwapBuffers(window);  // swap buffers
+		// only events that changed something get a new frame, see invalidateScene()
+		if (gSceneInvalid) {
+			// late latching: wait until just before the next blank, then take the newest input
+			const double latchTime = lateLatch ? latchInput(window, pacer) : glfwGetTime();
+
+			gSceneInvalid = false;
+			gDrawnFrames++;
+
+			// everything the input asked for since the last frame, in one update
+			if (gInput.EventCount() > 0) {
+				gInputEventCount += gInput.EventCount();
+				gInputUpdateCount++;
+				gInput.ApplyTo(M);
+			}
+
+			drawScene(instances ? &*instances : nullptr, shapes, outlines);
+
+			glFlush();	// ensure that all OpenGL calls have executed before swapping buffers
+
+			glfwSwapBuffers(window);  // swap buffers
+
+			pacer.Presented(glfwGetTime(), latchTime, gFirstInputTime);
+			gFirstInputTime = -1;
+		} else {
+			gSkippedFrames++;
+		}
+
         glfwWaitEvents(); // wait for a new event before re-drawing
 	} // end graphics loop
 
-	// Clean up
+	printf("drew %zu frames, skipped %zu wakeups with nothing to redraw\n", gDrawnFrames, gSkippedFrames);
+	printf("applied %zu input events to M in %zu updates\n", gInputEventCount, gInputUpdateCount);
+	pacer.PrintStatistics(lateLatch ? "late-latched frames" : "frames");
+
+	// Clean up; shapes and instances release their buffers while the context still exists
+	shapes.clear();
+	instances.reset();
 	glfwDestroyWindow(window);
 	glfwTerminate();  // destroys any remaining objects, frees resources allocated by GLFW
 	exit(EXIT_SUCCESS);
@@ -0,0 +1,125 @@
+// Assignment 2a - Programming Interactive 2D Graphics with OpenGL
+// Work by Jacob Secunda
+#ifndef HW2A_HEADLESSCONTEXT_HPP
+#define HW2A_HEADLESSCONTEXT_HPP
+
+#include <cstdio>
+#include <cstring>
+
+#include "glad/glad.h"
+
+#if HW2A_HAVE_EGL
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#endif
+
+// An OpenGL context with no window or surface at all, for rendering into
+// framebuffer objects on machines without a display.
+//
+// GLFW's null platform makes its contexts through OSMesa, which not every
+// server has; its EGL path still wants a window surface. Mesa's EGL can do
+// without one (EGL_MESA_platform_surfaceless with
+// EGL_KHR_surfaceless_context), so this makes that context directly. It is
+// only built where CMake found EGL; elsewhere Create() fails.
+class HeadlessContext {
+public:
+	HeadlessContext() = default;
+
+	HeadlessContext(const HeadlessContext&) = delete;
+	HeadlessContext& operator=(const HeadlessContext&) = delete;
+
+	~HeadlessContext()
+	{
+#if HW2A_HAVE_EGL
+		if (fDisplay == EGL_NO_DISPLAY)
+			return;
+
+		eglMakeCurrent(fDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+		if (fContext != EGL_NO_CONTEXT)
+			eglDestroyContext(fDisplay, fContext);
+
+		eglTerminate(fDisplay);
+#endif
+	}
+
+	// Description: Creates a core profile context of at least 'major'.'minor'
+	// and makes it current.
+	// 	- Returns false, having said why, if there is no such context to be had.
+	bool
+	Create(int major, int minor)
+	{
+#if HW2A_HAVE_EGL
+		// The surfaceless platform needs no display server; without it, take the default display
+		const char* clientExtensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+		const auto getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(
+			eglGetProcAddress("eglGetPlatformDisplayEXT"));
+		if (clientExtensions != nullptr && strstr(clientExtensions, "EGL_MESA_platform_surfaceless") != nullptr
+			&& getPlatformDisplay != nullptr)
+			fDisplay = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+		else
+			fDisplay = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+
+		if (fDisplay == EGL_NO_DISPLAY || !eglInitialize(fDisplay, nullptr, nullptr)) {
+			printf("EGL has no display to render with\n");
+			fDisplay = EGL_NO_DISPLAY;
+			return false;
+		}
+
+		const char* extensions = eglQueryString(fDisplay, EGL_EXTENSIONS);
+		if (extensions == nullptr || strstr(extensions, "EGL_KHR_surfaceless_context") == nullptr) {
+			printf("EGL can't make a context current without a surface\n");
+			return false;
+		}
+
+		// Rendering only ever goes to framebuffer objects, so any configuration will do
+		EGLConfig config = nullptr;
+		if (strstr(extensions, "EGL_KHR_no_config_context") == nullptr) {
+			const EGLint configAttributes[] = {EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT, EGL_NONE};
+			EGLint configCount = 0;
+			if (!eglChooseConfig(fDisplay, configAttributes, &config, 1, &configCount) || configCount == 0) {
+				printf("EGL has no configuration for OpenGL\n");
+				return false;
+			}
+		}
+
+		const EGLint contextAttributes[] = {
+			EGL_CONTEXT_MAJOR_VERSION, major,
+			EGL_CONTEXT_MINOR_VERSION, minor,
+			EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+			EGL_NONE
+		};
+
+		if (!eglBindAPI(EGL_OPENGL_API)
+			|| (fContext = eglCreateContext(fDisplay, config, EGL_NO_CONTEXT, contextAttributes)) == EGL_NO_CONTEXT
+			|| !eglMakeCurrent(fDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, fContext)) {
+			printf("EGL failed to create an OpenGL %d.%d context (error 0x%x)\n", major, minor, eglGetError());
+			return false;
+		}
+
+		return true;
+#else
+		printf("no EGL to create a surfaceless OpenGL %d.%d context with\n", major, minor);
+		return false;
+#endif
+	}
+
+	// Description: Returns what loads OpenGL functions for this context, for gladLoadGLLoader().
+	static GLADloadproc
+	ProcAddressLoader()
+	{
+#if HW2A_HAVE_EGL
+		return reinterpret_cast<GLADloadproc>(eglGetProcAddress);
+#else
+		return nullptr;
+#endif
+	}
+
+private:
+#if HW2A_HAVE_EGL
+	EGLDisplay fDisplay = EGL_NO_DISPLAY;
+	EGLContext fContext = EGL_NO_CONTEXT;
+#endif
+};
+
+
+#endif //HW2A_HEADLESSCONTEXT_HPP
@@ -0,0 +1,134 @@
+// Assignment 2a - Programming Interactive 2D Graphics with OpenGL
+// Work by Jacob Secunda
+#ifndef HW2A_INSTANCESET_HPP
+#define HW2A_INSTANCESET_HPP
+
+#include <algorithm>
+#include <cstdio>
+#include <span>
+#include <vector>
+
+#include "glad/glad.h"
+
+#include "core/AffineMatrix.hpp"
+#include "core/Model.hpp"
+#include "core/VertexFormat.hpp"
+
+// Per-copy transforms and tints for drawing one model many times with a
+// single glDrawElementsInstanced() call; see vshader2a_instanced.glsl.
+//
+// The copies live in two texture buffers the vertex shader indexes with
+// gl_InstanceID: the transforms as two RGBA32F texels each (the mat3x2
+// columns, then the translation), the tints as one RGBA8 texel each. That
+// keeps to OpenGL 3.2, which has no instanced vertex attributes, and costs
+// 36 bytes per copy.
+class InstanceSet {
+public:
+	// Texture units the buffers are bound to while drawing
+	static constexpr GLint kTransformUnit = 0;
+	static constexpr GLint kTintUnit = 1;
+
+	static constexpr GLint kTransformTexels = 2;
+
+public:
+	InstanceSet()
+	{
+		glGenBuffers(1, &fTransformBuffer);
+		glGenBuffers(1, &fTintBuffer);
+		glGenTextures(1, &fTransformTexture);
+		glGenTextures(1, &fTintTexture);
+	}
+
+	InstanceSet(const InstanceSet&) = delete;
+	InstanceSet& operator=(const InstanceSet&) = delete;
+
+	~InstanceSet()
+	{
+		glDeleteTextures(1, &fTintTexture);
+		glDeleteTextures(1, &fTransformTexture);
+		glDeleteBuffers(1, &fTintBuffer);
+		glDeleteBuffers(1, &fTransformBuffer);
+	}
+
+	// Description: Points 'program's samplers at the units Bind() uses; the
+	// program must be current.
+	static void
+	SetSamplers(GLuint program)
+	{
+		glUniform1i(glGetUniformLocation(program, "instance_transforms"), kTransformUnit);
+		glUniform1i(glGetUniformLocation(program, "instance_tints"), kTintUnit);
+	}
+
+	// Description: Replaces the copies with one per transform. Without
+	// 'tints' they keep the model's colors (an opaque white tint).
+	// 	- Returns false if the driver can't address that many copies.
+	bool
+	Set(std::span<const GLaffineMatrix> transforms, std::span<const ColorType3D> tints = {})
+	{
+		GLint maxTexels = 0;
+		glGetIntegerv(GL_MAX_TEXTURE_BUFFER_SIZE, &maxTexels);
+		if (transforms.size() * kTransformTexels > size_t(maxTexels)) {
+			printf("can't draw %zu copies; texture buffers hold at most %d texels\n", transforms.size(), maxTexels);
+			return false;
+		}
+
+		// Column-major, as the vertex shader rebuilds the mat3x2; the last texel's zw is unused
+		std::vector<GLfloat> transformData(transforms.size() * kTransformTexels * 4, 0.f);
+		fMaxScale = 0;
+		for (size_t instance = 0; instance < transforms.size(); instance++) {
+			std::copy_n(static_cast<const GLfloat*>(transforms[instance]), GLaffineMatrix::Size,
+				transformData.begin() + (instance * kTransformTexels * 4));
+			fMaxScale = std::max(fMaxScale, transforms[instance].MaxScale());
+		}
+
+		std::vector<GLubyte> tintData(transforms.size() * 4, 255);
+		for (size_t instance = 0; instance < std::min(tints.size(), transforms.size()); instance++) {
+			tintData[(instance * 4) + 0] = VertexFormat::Unorm8(tints[instance].r);
+			tintData[(instance * 4) + 1] = VertexFormat::Unorm8(tints[instance].g);
+			tintData[(instance * 4) + 2] = VertexFormat::Unorm8(tints[instance].b);
+		}
+
+		upload(fTransformBuffer, fTransformTexture, GL_RGBA32F, transformData.size() * sizeof(GLfloat), transformData.data());
+		upload(fTintBuffer, fTintTexture, GL_RGBA8, tintData.size(), tintData.data());
+
+		fCount = static_cast<GLsizei>(transforms.size());
+		return true;
+	}
+
+	[[nodiscard]] GLsizei Count() const { return fCount; }
+
+	// Description: The most any copy stretches the model, for picking its level of detail.
+	[[nodiscard]] GLfloat MaxScale() const { return fMaxScale; }
+
+	void
+	Bind() const
+	{
+		glActiveTexture(GL_TEXTURE0 + kTransformUnit);
+		glBindTexture(GL_TEXTURE_BUFFER, fTransformTexture);
+		glActiveTexture(GL_TEXTURE0 + kTintUnit);
+		glBindTexture(GL_TEXTURE_BUFFER, fTintTexture);
+		glActiveTexture(GL_TEXTURE0);
+	}
+
+private:
+	static void
+	upload(GLuint buffer, GLuint texture, GLenum format, GLsizeiptr size, const void* data)
+	{
+		glBindBuffer(GL_TEXTURE_BUFFER, buffer);
+		glBufferData(GL_TEXTURE_BUFFER, size, data, GL_STATIC_DRAW);
+		glBindTexture(GL_TEXTURE_BUFFER, texture);
+		glTexBuffer(GL_TEXTURE_BUFFER, format, buffer);
+	}
+
+private:
+	GLuint fTransformBuffer = 0;
+	GLuint fTintBuffer = 0;
+	GLuint fTransformTexture = 0;
+	GLuint fTintTexture = 0;
+
+	GLsizei fCount = 0;
+	GLfloat fMaxScale = 0;
+};
+
+
+#endif //HW2A_INSTANCESET_HPP
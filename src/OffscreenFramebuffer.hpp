@@ -0,0 +1,109 @@
+// Assignment 2a - Programming Interactive 2D Graphics with OpenGL
+// Work by Jacob Secunda
+#ifndef HW2A_OFFSCREENFRAMEBUFFER_HPP
+#define HW2A_OFFSCREENFRAMEBUFFER_HPP
+
+#include <cstdio>
+#include <vector>
+
+#include "glad/glad.h"
+
+// A framebuffer object to draw into instead of a window: an RGBA8 color
+// buffer and a depth/stencil buffer (for stencil-filled shapes) of a fixed
+// size, which can be read back and saved as a binary PPM image.
+class OffscreenFramebuffer {
+public:
+	OffscreenFramebuffer(GLsizei width, GLsizei height)
+		:
+		fWidth(width),
+		fHeight(height)
+	{
+		glGenFramebuffers(1, &fFramebuffer);
+		glBindFramebuffer(GL_FRAMEBUFFER, fFramebuffer);
+
+		glGenRenderbuffers(1, &fColorBuffer);
+		glBindRenderbuffer(GL_RENDERBUFFER, fColorBuffer);
+		glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, fWidth, fHeight);
+		glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, fColorBuffer);
+
+		glGenRenderbuffers(1, &fDepthStencilBuffer);
+		glBindRenderbuffer(GL_RENDERBUFFER, fDepthStencilBuffer);
+		glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, fWidth, fHeight);
+		glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, fDepthStencilBuffer);
+	}
+
+	OffscreenFramebuffer(const OffscreenFramebuffer&) = delete;
+	OffscreenFramebuffer& operator=(const OffscreenFramebuffer&) = delete;
+
+	~OffscreenFramebuffer()
+	{
+		glDeleteRenderbuffers(1, &fDepthStencilBuffer);
+		glDeleteRenderbuffers(1, &fColorBuffer);
+		glDeleteFramebuffers(1, &fFramebuffer);
+	}
+
+	[[nodiscard]] bool
+	IsComplete() const
+	{
+		glBindFramebuffer(GL_FRAMEBUFFER, fFramebuffer);
+		return glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+	}
+
+	// Description: Makes this the target of drawing, over its whole size.
+	void
+	Bind() const
+	{
+		glBindFramebuffer(GL_FRAMEBUFFER, fFramebuffer);
+		glViewport(0, 0, fWidth, fHeight);
+	}
+
+	// Description: Saves the color buffer as a binary PPM, top row first.
+	bool
+	WritePPM(const char* path) const
+	{
+		std::vector<GLubyte> pixels(size_t(fWidth) * fHeight * 4);
+		glBindFramebuffer(GL_FRAMEBUFFER, fFramebuffer);
+		glPixelStorei(GL_PACK_ALIGNMENT, 1);
+		glReadPixels(0, 0, fWidth, fHeight, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+
+		FILE* file = fopen(path, "wb");
+		if (file == nullptr) {
+			printf("can't write image file %s\n", path);
+			return false;
+		}
+
+		fprintf(file, "P6\n%d %d\n255\n", fWidth, fHeight);
+
+		// GL's rows start at the bottom
+		std::vector<GLubyte> row(size_t(fWidth) * 3);
+		bool succeeded = true;
+		for (GLsizei y = fHeight - 1; y >= 0 && succeeded; y--) {
+			const GLubyte* source = &pixels[size_t(y) * fWidth * 4];
+			for (GLsizei x = 0; x < fWidth; x++) {
+				row[(x * 3) + 0] = source[(x * 4) + 0];
+				row[(x * 3) + 1] = source[(x * 4) + 1];
+				row[(x * 3) + 2] = source[(x * 4) + 2];
+			}
+
+			succeeded = fwrite(row.data(), 1, row.size(), file) == row.size();
+		}
+
+		if (fclose(file) != 0 || !succeeded) {
+			printf("failed writing image file %s\n", path);
+			return false;
+		}
+
+		return true;
+	}
+
+private:
+	GLsizei fWidth;
+	GLsizei fHeight;
+
+	GLuint fFramebuffer = 0;
+	GLuint fColorBuffer = 0;
+	GLuint fDepthStencilBuffer = 0;
+};
+
+
+#endif //HW2A_OFFSCREENFRAMEBUFFER_HPP
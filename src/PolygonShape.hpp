@@ -0,0 +1,235 @@
+// Assignment 2a - Programming Interactive 2D Graphics with OpenGL
+// Work by Jacob Secunda
+#ifndef HW2A_POLYGONSHAPE_HPP
+#define HW2A_POLYGONSHAPE_HPP
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "glad/glad.h"
+
+#include "core/Shapes.hpp"
+#include "core/Triangulator.hpp"
+#include "ShaderStuff.hpp"
+
+// A filled polygon with its own vertex array, drawn in one of two ways:
+//
+// 	- FillMode::kTriangles triangulates the polygon on the CPU whenever its
+// 	  outline changes (see Triangulator.hpp), then draws indexed triangles.
+// 	- FillMode::kStencil never triangulates. Each ring is drawn as a fan
+// 	  from its first point with color writes off, inverting the stencil, so
+// 	  covered pixels end up odd (even-odd rule; holes come out even). A
+// 	  quad over the bounding box then colors the odd pixels and clears the
+// 	  stencil again. Changing the outline is one glBufferSubData() call.
+//
+// The shape is drawn through the current program with a constant color, so
+// it takes the same model transform as everything else. A polygon the
+// triangulator refuses (a self-intersecting outline, say) switches the shape
+// to FillMode::kStencil, which fills any outline.
+class PolygonShape {
+public:
+	PolygonShape(GLint positionLocation, GLint colorLocation)
+		:
+		fPositionLocation(positionLocation),
+		fColorLocation(colorLocation)
+	{
+		glGenVertexArrays(1, &fVertexArray);
+		glBindVertexArray(fVertexArray);
+
+		glGenBuffers(1, &fVertexBuffer);
+		glBindBuffer(GL_ARRAY_BUFFER, fVertexBuffer);
+		glGenBuffers(1, &fIndexBuffer);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, fIndexBuffer);
+
+		glEnableVertexAttribArray(fPositionLocation);
+		glVertexAttribPointer(fPositionLocation, 2, GL_FLOAT, GL_FALSE, 0, BUFFER_OFFSET(0));
+	}
+
+	PolygonShape(const PolygonShape&) = delete;
+	PolygonShape& operator=(const PolygonShape&) = delete;
+
+	PolygonShape(PolygonShape&& other) noexcept
+		:
+		fPositionLocation(other.fPositionLocation),
+		fColorLocation(other.fColorLocation),
+		fVertexArray(std::exchange(other.fVertexArray, 0)),
+		fVertexBuffer(std::exchange(other.fVertexBuffer, 0)),
+		fIndexBuffer(std::exchange(other.fIndexBuffer, 0)),
+		fVertexCapacity(other.fVertexCapacity),
+		fFillMode(other.fFillMode),
+		fColor(other.fColor),
+		fName(std::move(other.fName)),
+		fPolygon(std::move(other.fPolygon)),
+		fPositions(std::move(other.fPositions)),
+		fIndices(std::move(other.fIndices)),
+		fIndexCount(other.fIndexCount),
+		fRingFirsts(std::move(other.fRingFirsts)),
+		fRingCounts(std::move(other.fRingCounts)),
+		fCoverFirst(other.fCoverFirst)
+	{
+	}
+
+	PolygonShape& operator=(PolygonShape&& other) = delete;
+
+	~PolygonShape()
+	{
+		if (fVertexArray == 0)
+			return;
+
+		glDeleteBuffers(1, &fIndexBuffer);
+		glDeleteBuffers(1, &fVertexBuffer);
+		glDeleteVertexArrays(1, &fVertexArray);
+	}
+
+	void SetColor(const ColorType3D& color) { fColor = color; }
+
+	// Description: Sets the name printed when the shape has to change fill modes.
+	void SetName(std::string name) { fName = std::move(name); }
+
+	[[nodiscard]] FillMode GetFillMode() const { return fFillMode; }
+
+	void
+	SetFillMode(FillMode fillMode)
+	{
+		if (fillMode == fFillMode)
+			return;
+
+		fFillMode = fillMode;
+		upload();
+	}
+
+	// Description: Replaces the polygon and uploads it for the current fill mode.
+	void
+	SetPolygon(const Polygon2D<GLfloat>& polygon)
+	{
+		fPolygon = polygon;
+		upload();
+	}
+
+	void
+	Draw() const
+	{
+		glBindVertexArray(fVertexArray);
+		glVertexAttrib4f(fColorLocation, fColor.r, fColor.g, fColor.b, 1.f);
+
+		if (fFillMode == FillMode::kTriangles) {
+			glDrawElements(GL_TRIANGLES, fIndexCount, GL_UNSIGNED_INT, BUFFER_OFFSET(0));
+			return;
+		}
+
+		if (fRingFirsts.empty())
+			return;
+
+		glEnable(GL_STENCIL_TEST);
+
+		// Count coverage: every fan flips the low stencil bit of the pixels it covers
+		glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+		glStencilMask(1);
+		glStencilFunc(GL_ALWAYS, 0, 1);
+		glStencilOp(GL_KEEP, GL_KEEP, GL_INVERT);
+		glMultiDrawArrays(GL_TRIANGLE_FAN, fRingFirsts.data(), fRingCounts.data(), static_cast<GLsizei>(fRingFirsts.size()));
+
+		// Cover: color the odd pixels, zeroing the stencil behind us
+		glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+		glStencilFunc(GL_NOTEQUAL, 0, 1);
+		glStencilOp(GL_ZERO, GL_ZERO, GL_ZERO);
+		glDrawArrays(GL_TRIANGLE_FAN, fCoverFirst, 4);
+
+		glStencilMask(~0u);
+		glDisable(GL_STENCIL_TEST);
+	}
+
+private:
+	void
+	upload()
+	{
+		glBindVertexArray(fVertexArray);
+		glBindBuffer(GL_ARRAY_BUFFER, fVertexBuffer);  // not part of the vertex array's state
+
+		// Every ring goes into the buffer as it is: outline first, then each hole
+		fPositions.clear();
+		fRingFirsts.clear();
+		fRingCounts.clear();
+
+		const auto addRing = [&](const std::vector<Point2D<GLfloat>>& ring) {
+			// Rings too small to cover anything aren't drawn
+			if (ring.size() >= 3) {
+				fRingFirsts.push_back(static_cast<GLint>(fPositions.size()));
+				fRingCounts.push_back(static_cast<GLsizei>(ring.size()));
+			}
+
+			fPositions.insert(fPositions.end(), ring.begin(), ring.end());
+		};
+
+		addRing(fPolygon.outline);
+		for (const std::vector<Point2D<GLfloat>>& hole : fPolygon.holes)
+			addRing(hole);
+
+		if (fFillMode == FillMode::kTriangles) {
+			// Triangle indices refer to the points in the same order as fPositions
+			fIndices.clear();
+			if (!fTriangulator.Triangulate(fPolygon, fIndices) && fPolygon.outline.size() >= 3) {
+				printf("can't triangulate %s, filling it with the stencil instead\n", fName.c_str());
+				fFillMode = FillMode::kStencil;
+			}
+
+			fIndexCount = static_cast<GLsizei>(fIndices.size());
+			glBufferData(GL_ELEMENT_ARRAY_BUFFER, fIndices.size() * sizeof(uint32_t), fIndices.data(), GL_DYNAMIC_DRAW);
+		}
+
+		if (fFillMode == FillMode::kStencil) {
+			// Holes lie inside the outline, so its bounds cover everything
+			if (!fPolygon.outline.empty()) {
+				Point2D<GLfloat> minimum = fPolygon.outline[0];
+				Point2D<GLfloat> maximum = fPolygon.outline[0];
+				for (const Point2D<GLfloat>& point : fPolygon.outline) {
+					minimum = {std::min(minimum.x, point.x), std::min(minimum.y, point.y)};
+					maximum = {std::max(maximum.x, point.x), std::max(maximum.y, point.y)};
+				}
+
+				fCoverFirst = static_cast<GLint>(fPositions.size());
+				fPositions.insert(fPositions.end(), {minimum, {maximum.x, minimum.y}, maximum, {minimum.x, maximum.y}});
+			}
+		}
+
+		// Grow the buffer only when the outline outgrows it, otherwise update it in place
+		const GLsizeiptr size = fPositions.size() * sizeof(Point2D<GLfloat>);
+		if (fPositions.size() > fVertexCapacity) {
+			fVertexCapacity = fPositions.size();
+			glBufferData(GL_ARRAY_BUFFER, size, fPositions.data(), GL_DYNAMIC_DRAW);
+		} else {
+			glBufferSubData(GL_ARRAY_BUFFER, 0, size, fPositions.data());
+		}
+	}
+
+private:
+	GLint fPositionLocation;
+	GLint fColorLocation;
+
+	GLuint fVertexArray = 0;
+	GLuint fVertexBuffer = 0;
+	GLuint fIndexBuffer = 0;
+	size_t fVertexCapacity = 0;
+
+	FillMode fFillMode = FillMode::kTriangles;
+	ColorType3D fColor{0, 0, 0};
+	std::string fName = "polygon";
+	Polygon2D<GLfloat> fPolygon;
+	std::vector<Point2D<GLfloat>> fPositions;
+
+	// Triangles
+	PolygonTriangulator<GLfloat> fTriangulator;
+	std::vector<uint32_t> fIndices;
+	GLsizei fIndexCount = 0;
+
+	// Stencil
+	std::vector<GLint> fRingFirsts;
+	std::vector<GLsizei> fRingCounts;
+	GLint fCoverFirst = 0;
+};
+
+
+#endif //HW2A_POLYGONSHAPE_HPP
@@ -0,0 +1,346 @@
+// Assignment 2a - Programming Interactive 2D Graphics with OpenGL
+// Work by Jacob Secunda
+#ifndef HW2A_AFFINEMATRIX_HPP
+#define HW2A_AFFINEMATRIX_HPP
+
+#include "glad/glad.h"
+
+#include <array>
+#include <cmath>
+#include <iostream>
+#include <optional>
+
+#include "ConstexprMath.hpp"
+#include "Matrix.hpp"
+
+// A 2D affine transform stored as the six floats of a GLSL mat3x2
+// (column-major: 3 columns of 2 rows), uploaded with glUniformMatrix3x2fv:
+// 0	1	// X
+// 2	3	// Y
+// 4	5	// Translation
+//
+// x' = [0] * x + [2] * y + [4]
+// y' = [1] * x + [3] * y + [5]
+//
+// It offers the same TRS interface as Matrix and composes to the same
+// coefficients a Matrix4D would hold at 0, 1, 4, 5, 12 and 13.
+
+template<typename T>
+struct AffineMatrix2D {
+	// Constants
+	static constexpr size_t Rows = 2;
+	static constexpr size_t Columns = 3;
+	static constexpr size_t Size = Rows * Columns;
+
+	// Same parameters as Matrix
+	using Transforms = typename Matrix4D<T>::Transforms;
+
+public:
+	constexpr AffineMatrix2D()
+		:
+		fArray()
+	{
+		Reset();
+	}
+
+	// Copies are brought up to date, see Matrix
+	constexpr AffineMatrix2D(const AffineMatrix2D& other)
+	{
+		*this = other;
+	}
+
+	// Keeps the 2D affine part of 'matrix', dropping its TRS parameters
+	constexpr explicit AffineMatrix2D(const Matrix4D<T>& matrix)
+		:
+		fArray{matrix[0], matrix[1], matrix[4], matrix[5], matrix[12], matrix[13]}
+	{
+	}
+
+	constexpr AffineMatrix2D&
+	operator=(const AffineMatrix2D& other)
+	{
+		fArray = other.fArray;
+		fScaleX = other.fScaleX;
+		fScaleY = other.fScaleY;
+		fTranslateX = other.fTranslateX;
+		fTranslateY = other.fTranslateY;
+		fRotation = other.fRotation;
+		fNeedsUpdate = other.fNeedsUpdate;
+
+		updateIfNeeded();
+		return *this;
+	}
+
+	constexpr void
+	ApplyTransforms()
+	{
+		fNeedsUpdate = false;
+
+		// A zero factor is skipped, as in Matrix
+		const T scaleX = (fScaleX == 0) ? 1 : fScaleX;
+		const T scaleY = (fScaleY == 0) ? 1 : fScaleY;
+
+		T cosRads = 1;
+		T sinRads = 0;
+		if (fRotation != 0) {
+			cosRads = ConstexprMath::Cos<T>(fRotation);
+			sinRads = ConstexprMath::Sin<T>(fRotation);
+		}
+
+		fArray[0] = scaleX * cosRads;
+		fArray[1] = scaleX * -sinRads;
+		fArray[2] = scaleY * sinRads;
+		fArray[3] = scaleY * cosRads;
+		fArray[4] = fTranslateX;
+		fArray[5] = fTranslateY;
+	}
+
+	// Access like raw array
+	constexpr operator const T*() const { updateIfNeeded(); return fArray.data(); }
+
+	// Unchecked Access
+	constexpr T& operator[](size_t index) { updateIfNeeded(); return fArray[index]; }
+
+	constexpr const T& operator[](size_t index) const { updateIfNeeded(); return fArray[index]; }
+
+	/** Identity Matrix */
+	constexpr void
+	Identity()
+	{
+		fArray = {1, 0, 0, 1, 0, 0};
+	}
+
+	constexpr void
+	Reset()
+	{
+		fScaleX = 1.f;
+		fScaleY = 1.f;
+		fTranslateX = 0.f;
+		fTranslateY = 0.f;
+		fRotation = 0.f;
+
+		fNeedsUpdate = false;
+		Identity();
+	}
+
+	/** Scale */
+	constexpr void
+	ScaleUniformBy(const T& factor)
+	{
+		fScaleX += factor;
+		fScaleY += factor;
+
+		fNeedsUpdate = true;
+	}
+
+	constexpr void
+	ScaleXBy(const T& factor)
+	{
+		fScaleX += factor;
+		fNeedsUpdate = true;
+	}
+
+	constexpr void
+	ScaleYBy(const T& factor)
+	{
+		fScaleY += factor;
+		fNeedsUpdate = true;
+	}
+
+	/** Rotate */
+	constexpr void
+	Rotate2DBy(const T& radians)
+	{
+		fRotation += radians;
+		fNeedsUpdate = true;
+	}
+
+	/** Translate */
+	constexpr void
+	TranslateUniformBy(const T& offset)
+	{
+		fTranslateX += offset;
+		fTranslateY += offset;
+		fNeedsUpdate = true;
+	}
+
+	constexpr void
+	TranslateXBy(const T& offset)
+	{
+		fTranslateX += offset;
+		fNeedsUpdate = true;
+	}
+
+	constexpr void
+	TranslateYBy(const T& offset)
+	{
+		fTranslateY += offset;
+		fNeedsUpdate = true;
+	}
+
+	// Affine Composition
+	// Same order as Matrix::MultiplyBy: 'other' is applied after this transform.
+	// 12 multiplies and 8 adds instead of a 4x4 product's 64 and 48.
+	constexpr void
+	MultiplyBy(const AffineMatrix2D& other)
+	{
+		updateIfNeeded();
+
+		const T* a = fArray.data();
+		const T* b = other;
+		fArray = {
+			(b[0] * a[0]) + (b[2] * a[1]),
+			(b[1] * a[0]) + (b[3] * a[1]),
+			(b[0] * a[2]) + (b[2] * a[3]),
+			(b[1] * a[2]) + (b[3] * a[3]),
+			(b[0] * a[4]) + (b[2] * a[5]) + b[4],
+			(b[1] * a[4]) + (b[3] * a[5]) + b[5]
+		};
+	}
+
+	constexpr AffineMatrix2D&
+	operator*=(const AffineMatrix2D& other)
+	{
+		MultiplyBy(other);
+		return *this;
+	}
+
+	/** Inverse */
+
+	// Description: Inverts this transform.
+	// 	- Returns nothing when the transform is singular.
+	[[nodiscard]] constexpr std::optional<AffineMatrix2D>
+	Inverse() const
+	{
+		updateIfNeeded();
+
+		const T determinant = (fArray[0] * fArray[3]) - (fArray[1] * fArray[2]);
+		if (determinant == 0)
+			return {};
+
+		const T inverseDeterminant = 1 / determinant;
+
+		AffineMatrix2D inverse;
+		inverse.fArray[0] = fArray[3] * inverseDeterminant;
+		inverse.fArray[1] = -fArray[1] * inverseDeterminant;
+		inverse.fArray[2] = -fArray[2] * inverseDeterminant;
+		inverse.fArray[3] = fArray[0] * inverseDeterminant;
+		inverse.fArray[4] = -((inverse.fArray[0] * fArray[4]) + (inverse.fArray[2] * fArray[5]));
+		inverse.fArray[5] = -((inverse.fArray[1] * fArray[4]) + (inverse.fArray[3] * fArray[5]));
+
+		return inverse;
+	}
+
+	/** Decomposition */
+
+	// Description: Recovers scale, rotation and translation, see Matrix::Decompose().
+	[[nodiscard]] Transforms
+	Decompose() const
+	{
+		updateIfNeeded();
+
+		Transforms transforms{};
+		transforms.scaleX = std::hypot(fArray[0], fArray[1]);
+		transforms.rotation = std::atan2(-fArray[1], fArray[0]);
+		transforms.scaleY = (fArray[2] * std::sin(transforms.rotation)) + (fArray[3] * std::cos(transforms.rotation));
+		transforms.translateX = fArray[4];
+		transforms.translateY = fArray[5];
+		return transforms;
+	}
+
+	constexpr void
+	SetTransforms(const Transforms& transforms)
+	{
+		fScaleX = transforms.scaleX;
+		fScaleY = transforms.scaleY;
+		fRotation = transforms.rotation;
+		fTranslateX = transforms.translateX;
+		fTranslateY = transforms.translateY;
+
+		fNeedsUpdate = true;
+	}
+
+	[[nodiscard]] constexpr Transforms
+	GetTransforms() const
+	{
+		return {fScaleX, fScaleY, fRotation, fTranslateX, fTranslateY};
+	}
+
+	// Description: The most this transform stretches any direction, see Matrix::MaxScale().
+	[[nodiscard]] T
+	MaxScale() const
+	{
+		updateIfNeeded();
+		return Matrix4D<T>::MaxScale2x2(fArray[0], fArray[1], fArray[2], fArray[3]);
+	}
+
+	// Description: Expands this transform into the equivalent 4x4 matrix.
+	[[nodiscard]] constexpr Matrix4D<T>
+	ToMatrix4D() const
+	{
+		updateIfNeeded();
+
+		Matrix4D<T> matrix;
+		matrix[0] = fArray[0];
+		matrix[1] = fArray[1];
+		matrix[4] = fArray[2];
+		matrix[5] = fArray[3];
+		matrix[12] = fArray[4];
+		matrix[13] = fArray[5];
+		return matrix;
+	}
+
+private:
+	// Must not find a const object dirty, see Matrix::invalidateTransforms()
+	constexpr void
+	updateIfNeeded() const
+	{
+		if (fNeedsUpdate)
+			const_cast<AffineMatrix2D*>(this)->ApplyTransforms();
+	}
+
+private:
+	// Underlying Array
+	std::array<T, Size> fArray;
+	bool fNeedsUpdate = false;
+
+	float fScaleX = 1.f;
+	float fScaleY = 1.f;
+	float fTranslateX = 0.f;
+	float fTranslateY = 0.f;
+	float fRotation = 0.f;
+};
+
+/** Stream Operator */
+template<typename T>
+static std::ostream&
+operator<<(std::ostream& out, const AffineMatrix2D<T>& matrix)
+{
+	for (size_t row = 0; row < matrix.Rows; row++) {
+		out << "| ";
+		for (size_t column = 0; column < matrix.Columns; column++) {
+			out << matrix[(column * matrix.Rows) + row] << ' ';
+		}
+		out << "|\n";
+	}
+
+	return out;
+}
+
+template<typename T>
+static constexpr AffineMatrix2D<T>
+operator*(const AffineMatrix2D<T>& matrixA, const AffineMatrix2D<T>& matrixB)
+{
+	// Like a Matrix product, the result starts from fresh TRS parameters
+	AffineMatrix2D<T> matrixC;
+	matrixC.MultiplyBy(matrixA);
+	matrixC.MultiplyBy(matrixB);
+	return matrixC;
+}
+
+
+/** Types */
+using GLaffineMatrix = AffineMatrix2D<float>;
+
+
+#endif //HW2A_AFFINEMATRIX_HPP
@@ -0,0 +1,101 @@
+// Assignment 2a - Programming Interactive 2D Graphics with OpenGL
+// Work by Jacob Secunda
+#ifndef HW2A_CONSTEXPRMATH_HPP
+#define HW2A_CONSTEXPRMATH_HPP
+
+#include <cmath>
+#include <limits>
+#include <numbers>
+#include <type_traits>
+
+// Trig and square root usable in constant expressions.
+// At runtime these forward to <cmath>; during constant evaluation they use
+// series/iterative forms accurate to a few ULP of double, then round to T.
+namespace ConstexprMath {
+
+namespace detail {
+
+constexpr double
+ReduceAngle(double radians)
+{
+	// Bring into [-pi, pi] so the series below converges quickly
+	constexpr double twoPi = 2 * std::numbers::pi;
+	const double turns = radians / twoPi;
+	const double wholeTurns = static_cast<double>(static_cast<long long>(turns + (turns < 0 ? -0.5 : 0.5)));
+	return radians - (wholeTurns * twoPi);
+}
+
+
+// Taylor series, 'term' being the first term (x for sin, 1 for cos)
+constexpr double
+Series(double x, double term, int power)
+{
+	double sum = 0;
+	const double xSquared = x * x;
+	for (int step = 0; step < 16; step++) {
+		sum += term;
+		term *= -xSquared / ((power + 1) * (power + 2));
+		power += 2;
+	}
+
+	return sum;
+}
+
+} // namespace detail
+
+
+template<typename T>
+constexpr T
+Sin(T radians)
+{
+	if (!std::is_constant_evaluated())
+		return static_cast<T>(std::sin(radians));
+
+	const double x = detail::ReduceAngle(static_cast<double>(radians));
+	return static_cast<T>(detail::Series(x, x, 1));
+}
+
+
+template<typename T>
+constexpr T
+Cos(T radians)
+{
+	if (!std::is_constant_evaluated())
+		return static_cast<T>(std::cos(radians));
+
+	const double x = detail::ReduceAngle(static_cast<double>(radians));
+	return static_cast<T>(detail::Series(x, 1.0, 0));
+}
+
+
+template<typename T>
+constexpr T
+Sqrt(T value)
+{
+	if (!std::is_constant_evaluated())
+		return static_cast<T>(std::sqrt(value));
+
+	const double x = static_cast<double>(value);
+	if (x < 0 || x != x)
+		return std::numeric_limits<T>::quiet_NaN();
+	if (x == 0 || x == std::numeric_limits<double>::infinity())
+		return value;
+
+	// Newton-Raphson from above converges monotonically, so stop once it
+	// no longer decreases
+	double estimate = (x > 1) ? x : 1;
+	while (true) {
+		const double next = 0.5 * (estimate + (x / estimate));
+		if (next >= estimate)
+			break;
+
+		estimate = next;
+	}
+
+	return static_cast<T>(estimate);
+}
+
+} // namespace ConstexprMath
+
+
+#endif //HW2A_CONSTEXPRMATH_HPP
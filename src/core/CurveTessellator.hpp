@@ -0,0 +1,282 @@
+// Assignment 2a - Programming Interactive 2D Graphics with OpenGL
+// Work by Jacob Secunda
+#ifndef HW2A_CURVETESSELLATOR_HPP
+#define HW2A_CURVETESSELLATOR_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <numbers>
+#include <utility>
+#include <vector>
+
+#include "Point.hpp"
+#include "Triangulator.hpp"
+
+// A closed outline made of lines, quadratic and cubic Bezier curves and
+// circular arcs, flattened to points on demand.
+//
+// Each curve is split into the fewest equal parameter steps that keep the
+// polyline within 'tolerance' of it: Wang's formula for Bezier curves, the
+// sagitta of a chord for arcs. Lines are never split, so a path without
+// curves flattens to exactly its points at any tolerance.
+template<typename T>
+class Path2D {
+public:
+	// Upper bound on the pieces of one curve, however small the tolerance
+	static constexpr uint32_t kMaxCurveSegments = 1024;
+
+public:
+	// Description: Adds a straight edge to 'point'; the first one starts the path.
+	void
+	LineTo(const Point2D<T>& point)
+	{
+		fSegments.push_back({SegmentType::kLine, {point}});
+	}
+
+	// Description: Adds a curve from the current point; the path must already have a point.
+	void
+	QuadraticTo(const Point2D<T>& control, const Point2D<T>& end)
+	{
+		fSegments.push_back({SegmentType::kQuadratic, {control, end}});
+		fHasCurves = true;
+	}
+
+	void
+	CubicTo(const Point2D<T>& control1, const Point2D<T>& control2, const Point2D<T>& end)
+	{
+		fSegments.push_back({SegmentType::kCubic, {control1, control2, end}});
+		fHasCurves = true;
+	}
+
+	// Description: Adds an arc around 'center' from 'startAngle' to 'endAngle'
+	// (radians, counter-clockwise when endAngle is larger), joined to the
+	// current point, if any, by a straight edge.
+	void
+	ArcTo(const Point2D<T>& center, T radius, T startAngle, T endAngle)
+	{
+		Segment segment{SegmentType::kArc, {center}};
+		segment.radius = radius;
+		segment.startAngle = startAngle;
+		segment.endAngle = endAngle;
+		fSegments.push_back(segment);
+		fHasCurves = true;
+	}
+
+	[[nodiscard]] bool Empty() const { return fSegments.empty(); }
+
+	[[nodiscard]] bool HasCurves() const { return fHasCurves; }
+
+	// Description: Replaces 'points' with the flattened outline. The closing
+	// point is left out when it repeats the first, and so is an arc's first
+	// point when it repeats the previous one (within 'tolerance').
+	void
+	Tessellate(T tolerance, std::vector<Point2D<T>>& points) const
+	{
+		points.clear();
+
+		for (const Segment& segment : fSegments) {
+			switch (segment.type) {
+				case SegmentType::kLine:
+					points.push_back(segment.points[0]);
+					break;
+
+				case SegmentType::kQuadratic: {
+					const Point2D<T> start = points.empty() ? segment.points[1] : points.back();
+					const Point2D<T>& control = segment.points[0];
+					const Point2D<T>& end = segment.points[1];
+
+					// Wang's formula for degree 2: n = sqrt(|p0 - 2p1 + p2| / (4 tolerance))
+					const uint32_t count = segmentCount(std::sqrt(length(secondDifference(start, control, end)) / (4 * tolerance)));
+					for (uint32_t step = 1; step <= count; step++) {
+						const T t = T(step) / count;
+						const T u = 1 - t;
+						points.push_back({(u * u * start.x) + (2 * u * t * control.x) + (t * t * end.x),
+							(u * u * start.y) + (2 * u * t * control.y) + (t * t * end.y)});
+					}
+					break;
+				}
+
+				case SegmentType::kCubic: {
+					const Point2D<T> start = points.empty() ? segment.points[2] : points.back();
+					const Point2D<T>& control1 = segment.points[0];
+					const Point2D<T>& control2 = segment.points[1];
+					const Point2D<T>& end = segment.points[2];
+
+					// Wang's formula for degree 3: n = sqrt(3 max|p(i) - 2p(i+1) + p(i+2)| / (4 tolerance))
+					const T curvature = std::max(length(secondDifference(start, control1, control2)),
+						length(secondDifference(control1, control2, end)));
+					const uint32_t count = segmentCount(std::sqrt((3 * curvature) / (4 * tolerance)));
+					for (uint32_t step = 1; step <= count; step++) {
+						const T t = T(step) / count;
+						const T u = 1 - t;
+						const T a = u * u * u;
+						const T b = 3 * u * u * t;
+						const T c = 3 * u * t * t;
+						const T d = t * t * t;
+						points.push_back({(a * start.x) + (b * control1.x) + (c * control2.x) + (d * end.x),
+							(a * start.y) + (b * control1.y) + (c * control2.y) + (d * end.y)});
+					}
+					break;
+				}
+
+				case SegmentType::kArc: {
+					const Point2D<T>& center = segment.points[0];
+					const T radius = std::abs(segment.radius);
+					const T sweep = segment.endAngle - segment.startAngle;
+
+					// A chord spanning 'angle' strays r (1 - cos(angle / 2)) from the arc;
+					// at least three pieces per full turn
+					T angle = std::numbers::pi_v<T> * 2 / 3;
+					if (tolerance < radius)
+						angle = std::min(angle, 2 * std::acos(1 - (tolerance / radius)));
+
+					// The arc's first point is dropped when it lands on the current one
+					const uint32_t count = segmentCount(std::abs(sweep) / angle);
+					const Point2D<T> first{center.x + (radius * std::cos(segment.startAngle)), center.y + (radius * std::sin(segment.startAngle))};
+					if (points.empty() || !nearlyEqual(points.back(), first, tolerance))
+						points.push_back(first);
+
+					for (uint32_t step = 1; step <= count; step++) {
+						const T theta = segment.startAngle + ((sweep * T(step)) / count);
+						points.push_back({center.x + (radius * std::cos(theta)), center.y + (radius * std::sin(theta))});
+					}
+					break;
+				}
+			}
+		}
+
+		if (points.size() > 1 && nearlyEqual(points.front(), points.back(), tolerance))
+			points.pop_back();
+	}
+
+private:
+	enum class SegmentType : uint8_t {
+		kLine,
+		kQuadratic,
+		kCubic,
+		kArc
+	};
+
+	struct Segment {
+		SegmentType type;
+		Point2D<T> points[3];	// end point last; an arc's center
+		T radius = 0;
+		T startAngle = 0;
+		T endAngle = 0;
+	};
+
+	static Point2D<T>
+	secondDifference(const Point2D<T>& a, const Point2D<T>& b, const Point2D<T>& c)
+	{
+		return {a.x - (2 * b.x) + c.x, a.y - (2 * b.y) + c.y};
+	}
+
+	static T length(const Point2D<T>& vector) { return std::hypot(vector.x, vector.y); }
+
+	static bool
+	nearlyEqual(const Point2D<T>& a, const Point2D<T>& b, T tolerance)
+	{
+		return length({a.x - b.x, a.y - b.y}) <= tolerance;
+	}
+
+	static uint32_t
+	segmentCount(T exact)
+	{
+		if (!(exact > 1))
+			return 1;
+
+		return static_cast<uint32_t>(std::ceil(std::min<T>(exact, kMaxCurveSegments)));
+	}
+
+private:
+	std::vector<Segment> fSegments;
+	bool fHasCurves = false;
+};
+
+
+// A polygon whose outline and holes may be curved
+template<typename T>
+struct CurvedPolygon2D {
+	Path2D<T> outline;
+	std::vector<Path2D<T>> holes;
+
+public:
+	[[nodiscard]] bool
+	HasCurves() const
+	{
+		return outline.HasCurves()
+			|| std::any_of(holes.begin(), holes.end(), [](const Path2D<T>& hole) { return hole.HasCurves(); });
+	}
+
+	void
+	Tessellate(T tolerance, Polygon2D<T>& polygon) const
+	{
+		outline.Tessellate(tolerance, polygon.outline);
+		polygon.holes.resize(holes.size());
+		for (size_t hole = 0; hole < holes.size(); hole++)
+			holes[hole].Tessellate(tolerance, polygon.holes[hole]);
+	}
+};
+
+
+// Keeps a CurvedPolygon2D flattened for the scale it is drawn at.
+//
+// Scales are grouped into zoom levels a factor of kZoomStep apart, and each
+// level is flattened for its largest scale, so the error stays under the
+// pixel tolerance anywhere in the level. Zooming within a level reuses the
+// cached points; only crossing into another level flattens again.
+template<typename T>
+class TessellatedPolygon {
+public:
+	static constexpr T kZoomStep = 2;
+	static constexpr T kDefaultPixelTolerance = T(0.25);
+
+public:
+	explicit TessellatedPolygon(CurvedPolygon2D<T> shape, T pixelTolerance = kDefaultPixelTolerance)
+		:
+		fShape(std::move(shape)),
+		fPixelTolerance(pixelTolerance)
+	{
+	}
+
+	// Description: Brings Polygon() up to date for drawing at 'pixelScale'
+	// pixels per unit (e.g. the model matrix's MaxScale() times the viewport's
+	// half-size in pixels).
+	// 	- Returns true when Polygon() changed and needs uploading again.
+	bool
+	Update(T pixelScale)
+	{
+		int level = kNoLevel;
+		if (pixelScale > 0)
+			level = std::clamp(static_cast<int>(std::floor(std::log(pixelScale) / std::log(kZoomStep))), kNoLevel, -kNoLevel);
+
+		// Straight edges look the same at any scale
+		if (fFlattened && (level == fLevel || !fShape.HasCurves()))
+			return false;
+
+		const T levelScale = std::pow(kZoomStep, T(level + 1));
+		fShape.Tessellate(fPixelTolerance / levelScale, fPolygon);
+		fLevel = level;
+		fFlattened = true;
+		return true;
+	}
+
+	[[nodiscard]] const Polygon2D<T>& Polygon() const { return fPolygon; }
+
+	[[nodiscard]] const CurvedPolygon2D<T>& Shape() const { return fShape; }
+
+private:
+	// Levels are kept within +/- this; it also stands in for a degenerate scale
+	static constexpr int kNoLevel = -32;
+
+	CurvedPolygon2D<T> fShape;
+	T fPixelTolerance;
+
+	Polygon2D<T> fPolygon;
+	int fLevel = kNoLevel;
+	bool fFlattened = false;
+};
+
+
+#endif //HW2A_CURVETESSELLATOR_HPP
@@ -0,0 +1,87 @@
+// Assignment 2a - Programming Interactive 2D Graphics with OpenGL
+// Work by Jacob Secunda
+#ifndef HW2A_FRAMEPACER_HPP
+#define HW2A_FRAMEPACER_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+
+// Predicts vertical blanks from when swaps return, picks the moment to
+// sample input for the next frame, and measures input-to-present latency.
+//
+// With vsync a swap returns at about the blank that shows the frame, so
+// later blanks are predicted a refresh period apart from the last one.
+// Input is latched a deadline ahead of the next predicted blank: late
+// enough that the frame shows the newest input, early enough to draw and
+// swap in time. All times are in seconds from one clock (glfwGetTime()).
+class FramePacer {
+public:
+	static constexpr double kDefaultRefreshRate = 60;
+	static constexpr double kDefaultDeadline = 0.004;
+
+public:
+	FramePacer(double refreshRate, double deadline)
+		:
+		fPeriod(1 / ((refreshRate > 0) ? refreshRate : kDefaultRefreshRate)),
+		fDeadline(std::clamp(deadline, 0.0, fPeriod))
+	{
+	}
+
+	// Description: Returns when to sample input for the first blank that
+	// still leaves the deadline after 'now', or 'now' before any swap.
+	[[nodiscard]] double
+	LatchTime(double now) const
+	{
+		if (fLastPresent < 0)
+			return now;
+
+		const double periods = std::max(0.0, std::floor((now + fDeadline - fLastPresent) / fPeriod)) + 1;
+		return fLastPresent + (periods * fPeriod) - fDeadline;
+	}
+
+	// Description: Records a swap that returned at 'presentTime', showing
+	// input that arrived from 'firstInputTime' (negative when the frame had
+	// none) and was latched at 'latchTime'.
+	void
+	Presented(double presentTime, double latchTime, double firstInputTime)
+	{
+		fLastPresent = presentTime;
+
+		if (firstInputTime < 0)
+			return;
+
+		const double latency = presentTime - firstInputTime;
+		fInputFrames++;
+		fLatencySum += latency;
+		fMaxLatency = std::max(fMaxLatency, latency);
+		fLatchToPresentSum += presentTime - latchTime;
+	}
+
+	void
+	PrintStatistics(const char* label) const
+	{
+		if (fInputFrames == 0) {
+			printf("%s: no frames with input\n", label);
+			return;
+		}
+
+		printf("%s: input-to-present latency %.2f ms mean, %.2f ms max; latch-to-present %.2f ms mean over %zu frames\n",
+			label, 1000 * fLatencySum / double(fInputFrames), 1000 * fMaxLatency,
+			1000 * fLatchToPresentSum / double(fInputFrames), fInputFrames);
+	}
+
+private:
+	double fPeriod;
+	double fDeadline;
+	double fLastPresent = -1;
+
+	size_t fInputFrames = 0;
+	double fLatencySum = 0;
+	double fMaxLatency = 0;
+	double fLatchToPresentSum = 0;
+};
+
+
+#endif //HW2A_FRAMEPACER_HPP
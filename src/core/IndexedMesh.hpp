@@ -0,0 +1,149 @@
+// Assignment 2a - Programming Interactive 2D Graphics with OpenGL
+// Work by Jacob Secunda
+#ifndef HW2A_INDEXEDMESH_HPP
+#define HW2A_INDEXEDMESH_HPP
+
+#include "glad/glad.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include "Model.hpp"
+
+// A triangle list split into unique vertices and indices into them, drawn
+// with glDrawElements(). Vertices that repeat in the source (like the
+// center of the default model) are stored, and shaded, once.
+struct IndexedMesh {
+	Model vertices;
+	std::vector<uint32_t> indices;
+
+	// Vertex count of the model this was built from
+	size_t sourceVertexCount = 0;
+
+public:
+	// 16-bit indices whenever every vertex can be addressed with them
+	[[nodiscard]] GLenum
+	IndexType() const
+	{
+		return (vertices.VertexCount() <= size_t(std::numeric_limits<uint16_t>::max()) + 1)
+			? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+	}
+
+	[[nodiscard]] size_t IndexSize() const { return (IndexType() == GL_UNSIGNED_SHORT) ? sizeof(uint16_t) : sizeof(uint32_t); }
+
+	// Description: Returns the indices at IndexSize() bytes each, ready for
+	// GL_ELEMENT_ARRAY_BUFFER.
+	[[nodiscard]] std::vector<std::byte>
+	PackIndices() const
+	{
+		std::vector<std::byte> data(indices.size() * IndexSize());
+		if (IndexType() == GL_UNSIGNED_INT) {
+			memcpy(data.data(), indices.data(), data.size());
+			return data;
+		}
+
+		for (size_t index = 0; index < indices.size(); index++) {
+			const uint16_t shortIndex = static_cast<uint16_t>(indices[index]);
+			memcpy(data.data() + (index * sizeof(uint16_t)), &shortIndex, sizeof(uint16_t));
+		}
+
+		return data;
+	}
+
+	// Description: Prints how many vertices indexing removed, and what it
+	// saved for vertices of 'vertexSize' bytes.
+	void
+	PrintReduction(const char* name, size_t vertexSize) const
+	{
+		const size_t uniqueCount = vertices.VertexCount();
+		const size_t sourceBytes = sourceVertexCount * vertexSize;
+		const size_t indexedBytes = (uniqueCount * vertexSize) + (indices.size() * IndexSize());
+
+		printf("%s: %zu vertices -> %zu unique (%.2fx fewer), %zu bytes -> %zu bytes with %zu-bit indices\n",
+			name, sourceVertexCount, uniqueCount, (uniqueCount > 0) ? double(sourceVertexCount) / uniqueCount : 1.0,
+			sourceBytes, indexedBytes, IndexSize() * 8);
+	}
+};
+
+
+namespace IndexedMeshDetail {
+
+// Vertices are compared by their bits, so only exact repeats are merged
+struct VertexKey {
+	uint32_t bits[5];
+
+	VertexKey(const FloatType2D& vertex, const ColorType3D& color)
+	{
+		memcpy(bits, &vertex, sizeof(FloatType2D));
+		memcpy(bits + 2, &color, sizeof(ColorType3D));
+	}
+
+	[[nodiscard]] bool operator==(const VertexKey& other) const { return memcmp(bits, other.bits, sizeof(bits)) == 0; }
+
+	[[nodiscard]] uint64_t
+	Hash() const
+	{
+		// FNV-1a over the five words, then a final avalanche
+		uint64_t hash = 14695981039346656037ull;
+		for (uint32_t word : bits)
+			hash = (hash ^ word) * 1099511628211ull;
+
+		return hash ^ (hash >> 32);
+	}
+};
+
+} // namespace IndexedMeshDetail
+
+
+// Description: Builds an IndexedMesh from a triangle list by hashing each
+// (position, color) pair.
+// 	- Unique vertices keep the order in which they first appear.
+// 	- The hash table is one open-addressed array of vertex numbers, sized
+// 	  once up front.
+static inline IndexedMesh
+BuildIndexedMesh(const Model& model)
+{
+	const size_t vertexCount = model.VertexCount();
+
+	IndexedMesh mesh;
+	mesh.sourceVertexCount = vertexCount;
+	mesh.indices.reserve(vertexCount);
+
+	// Power of two, at most half full
+	const size_t tableSize = std::bit_ceil(std::max<size_t>(vertexCount * 2, 16));
+	const size_t tableMask = tableSize - 1;
+	static constexpr uint32_t kEmpty = std::numeric_limits<uint32_t>::max();
+	std::vector<uint32_t> table(tableSize, kEmpty);
+
+	for (size_t vertex = 0; vertex < vertexCount; vertex++) {
+		const IndexedMeshDetail::VertexKey key(model.vertices[vertex], model.colors[vertex]);
+
+		size_t slot = key.Hash() & tableMask;
+		while (table[slot] != kEmpty) {
+			const uint32_t unique = table[slot];
+			if (IndexedMeshDetail::VertexKey(mesh.vertices.vertices[unique], mesh.vertices.colors[unique]) == key)
+				break;
+
+			slot = (slot + 1) & tableMask;
+		}
+
+		if (table[slot] == kEmpty) {
+			table[slot] = static_cast<uint32_t>(mesh.vertices.VertexCount());
+			mesh.vertices.vertices.push_back(model.vertices[vertex]);
+			mesh.vertices.colors.push_back(model.colors[vertex]);
+		}
+
+		mesh.indices.push_back(table[slot]);
+	}
+
+	return mesh;
+}
+
+
+#endif //HW2A_INDEXEDMESH_HPP
@@ -0,0 +1,87 @@
+// Assignment 2a - Programming Interactive 2D Graphics with OpenGL
+// Work by Jacob Secunda
+#ifndef HW2A_INPUTACCUMULATOR_HPP
+#define HW2A_INPUTACCUMULATOR_HPP
+
+#include <cstddef>
+
+// Collects the transform changes input events ask for between two frames,
+// so they reach the model matrix once per frame however fast the device
+// reports.
+//
+// It offers the TRS calls of Matrix and AffineMatrix2D. Those only add to
+// the matrix's scale, rotation and translation parameters, so summing the
+// deltas first and applying the sums ends in the same transform; a Reset()
+// drops what came before it.
+template<typename T>
+class InputAccumulator {
+public:
+	void ScaleXBy(const T& factor) { fScaleX += factor; fEventCount++; }
+
+	void ScaleYBy(const T& factor) { fScaleY += factor; fEventCount++; }
+
+	void Rotate2DBy(const T& radians) { fRotation += radians; fEventCount++; }
+
+	void TranslateXBy(const T& offset) { fTranslateX += offset; fEventCount++; }
+
+	void TranslateYBy(const T& offset) { fTranslateY += offset; fEventCount++; }
+
+	void
+	Reset()
+	{
+		clearDeltas();
+		fReset = true;
+		fEventCount++;
+	}
+
+	// Description: Input events collected since the last ApplyTo().
+	[[nodiscard]] size_t EventCount() const { return fEventCount; }
+
+	// Description: Applies everything collected to 'matrix' and starts over.
+	template<typename Matrix>
+	void
+	ApplyTo(Matrix& matrix)
+	{
+		if (fReset)
+			matrix.Reset();
+
+		if (fScaleX != 0)
+			matrix.ScaleXBy(fScaleX);
+		if (fScaleY != 0)
+			matrix.ScaleYBy(fScaleY);
+		if (fRotation != 0)
+			matrix.Rotate2DBy(fRotation);
+		if (fTranslateX != 0)
+			matrix.TranslateXBy(fTranslateX);
+		if (fTranslateY != 0)
+			matrix.TranslateYBy(fTranslateY);
+
+		clearDeltas();
+		fReset = false;
+		fEventCount = 0;
+	}
+
+private:
+	void
+	clearDeltas()
+	{
+		fScaleX = 0;
+		fScaleY = 0;
+		fRotation = 0;
+		fTranslateX = 0;
+		fTranslateY = 0;
+	}
+
+private:
+	bool fReset = false;
+	T fScaleX = 0;
+	T fScaleY = 0;
+	T fRotation = 0;
+	T fTranslateX = 0;
+	T fTranslateY = 0;
+
+	size_t fEventCount = 0;
+};
+
+
+#endif //HW2A_INPUTACCUMULATOR_HPP
@@ -0,0 +1,167 @@
+// Assignment 2a - Programming Interactive 2D Graphics with OpenGL
+// Work by Jacob Secunda
+#ifndef HW2A_MAPPEDFILE_HPP
+#define HW2A_MAPPEDFILE_HPP
+
+#include <cstddef>
+#include <cstdio>
+#include <utility>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// A read-only view of a whole file through the virtual memory system.
+//
+// Pages are only read from disk when they are first touched, and nothing is
+// copied into the process: Data() can be handed straight to glBufferData.
+class MappedFile {
+public:
+	MappedFile() = default;
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	MappedFile(MappedFile&& other) noexcept
+		:
+		fData(std::exchange(other.fData, nullptr)),
+		fSize(std::exchange(other.fSize, 0))
+	{
+	}
+
+	MappedFile&
+	operator=(MappedFile&& other) noexcept
+	{
+		if (this != &other) {
+			Close();
+			fData = std::exchange(other.fData, nullptr);
+			fSize = std::exchange(other.fSize, 0);
+		}
+
+		return *this;
+	}
+
+	~MappedFile()
+	{
+		Close();
+	}
+
+	// Description: Maps all of 'path'.
+	// 	- Returns false, with a message, if the file can't be opened or mapped.
+	// 	- An empty file opens successfully with a null Data().
+	bool
+	Open(const char* path)
+	{
+		Close();
+
+#ifdef _WIN32
+		HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+			FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		if (file == INVALID_HANDLE_VALUE) {
+			printf("can't open file %s\n", path);
+			return false;
+		}
+
+		LARGE_INTEGER size;
+		if (!GetFileSizeEx(file, &size)) {
+			printf("can't read the size of file %s\n", path);
+			CloseHandle(file);
+			return false;
+		}
+
+		if (size.QuadPart == 0) {
+			CloseHandle(file);
+			return true;
+		}
+
+		HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		CloseHandle(file);
+		if (mapping == nullptr) {
+			printf("can't map file %s\n", path);
+			return false;
+		}
+
+		void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+		CloseHandle(mapping);
+		if (data == nullptr) {
+			printf("can't map file %s\n", path);
+			return false;
+		}
+
+		fData = static_cast<const std::byte*>(data);
+		fSize = static_cast<size_t>(size.QuadPart);
+#else
+		const int file = open(path, O_RDONLY);
+		if (file < 0) {
+			printf("can't open file %s\n", path);
+			return false;
+		}
+
+		struct stat status;
+		if (fstat(file, &status) != 0) {
+			printf("can't read the size of file %s\n", path);
+			close(file);
+			return false;
+		}
+
+		if (status.st_size == 0) {
+			close(file);
+			return true;
+		}
+
+		void* data = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+		close(file);
+		if (data == MAP_FAILED) {
+			printf("can't map file %s\n", path);
+			return false;
+		}
+
+		// The whole file is about to be read front to back
+		madvise(data, static_cast<size_t>(status.st_size), MADV_SEQUENTIAL);
+		madvise(data, static_cast<size_t>(status.st_size), MADV_WILLNEED);
+
+		fData = static_cast<const std::byte*>(data);
+		fSize = static_cast<size_t>(status.st_size);
+#endif
+
+		return true;
+	}
+
+	void
+	Close()
+	{
+		if (fData == nullptr)
+			return;
+
+#ifdef _WIN32
+		UnmapViewOfFile(fData);
+#else
+		munmap(const_cast<std::byte*>(fData), fSize);
+#endif
+
+		fData = nullptr;
+		fSize = 0;
+	}
+
+	[[nodiscard]] const std::byte* Data() const { return fData; }
+
+	[[nodiscard]] size_t Size() const { return fSize; }
+
+private:
+	const std::byte* fData = nullptr;
+	size_t fSize = 0;
+};
+
+
+#endif //HW2A_MAPPEDFILE_HPP
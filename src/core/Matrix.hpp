@@ -5,9 +5,15 @@
 
 #include "glad/glad.h"
 
+#include <algorithm>
 #include <array>
+#include <cmath>
 #include <optional>
+#include <utility>
 
+#include "ConstexprMath.hpp"
+#include "MatrixKernels.hpp"
+#include "MatrixProduct.hpp"
 #include "Point.hpp"
 #include "Vector3D.hpp"
 
@@ -28,41 +34,105 @@ struct Matrix {
 	static constexpr size_t Size = Rows * Columns;
 
 public:
-	Matrix()
+	constexpr Matrix()
 		:
 		fArray()
 	{
 		Reset();
 	}
 
+	// Copies are brought up to date, so a const copy has no pending
+	// transforms for its const accessors to compose.
+	constexpr Matrix(const Matrix& other)
+	{
+		*this = other;
+	}
+
+	constexpr Matrix&
+	operator=(const Matrix& other)
+	{
+		fArray = other.fArray;
+		fScaleX = other.fScaleX;
+		fScaleY = other.fScaleY;
+		fTranslateX = other.fTranslateX;
+		fTranslateY = other.fTranslateY;
+		fRotation = other.fRotation;
+		fNeedsUpdate = other.fNeedsUpdate;
+
+		updateIfNeeded();
+		return *this;
+	}
+
+	// Products are evaluated straight into the new matrix
+	template<typename Left, typename Right>
+	constexpr Matrix(const MatrixProduct<Left, Right>& product)
+	{
+		product.EvaluateInto(fArray.data());
+	}
+
+	template<typename Left, typename Right>
+	constexpr Matrix&
+	operator=(const MatrixProduct<Left, Right>& product)
+	{
+		if (product.References(this)) {
+			std::array<T, Size> result;
+			product.EvaluateInto(result.data());
+			fArray = result;
+		} else {
+			product.EvaluateInto(fArray.data());
+		}
+
+		// Same as copying a freshly constructed product
+		resetTransforms();
+		return *this;
+	}
+
 	constexpr void
 	ApplyTransforms()
 	{
-		Identity();
+		fNeedsUpdate = false;
 
-		// Apply Scaling
-		doScaleX(fScaleX);
-		doScaleY(fScaleY);
+		if constexpr (Dimensions == 4) {
+			composeAffine2D();
+		} else {
+			Identity();
 
-		// Apply Rotation
-		doRotate2D(fRotation);
+			// Apply Scaling
+			doScaleX(fScaleX);
+			if constexpr (Dimensions >= 2) {
+				doScaleY(fScaleY);
 
-		// Apply Translation
-		doTranslateX(fTranslateX);
-		doTranslateY(fTranslateY);
+				// Apply Rotation
+				doRotate2D(fRotation);
+			}
+
+			// Apply Translation
+			if constexpr (Dimensions >= 3) {
+				doTranslateX(fTranslateX);
+				doTranslateY(fTranslateY);
+			}
+		}
 	}
 
 	// Access like raw array
-	constexpr operator const T*() const { return fArray.data(); }
+	constexpr operator const T*() const { updateIfNeeded(); return fArray.data(); }
 
 	// Unchecked Access
-	constexpr T& operator[](size_t index) { return fArray[index]; }
+	constexpr T& operator[](size_t index) { updateIfNeeded(); return fArray[index]; }
 
-	constexpr const T& operator[](size_t index) const { return fArray[index]; }
+	constexpr const T& operator[](size_t index) const { updateIfNeeded(); return fArray[index]; }
 
-	constexpr T& operator()(size_t row, size_t column) { return fArray[rowAndColToIndex(row, column)]; }
+	constexpr T& operator()(size_t row, size_t column)
+	{
+		updateIfNeeded();
+		return fArray[rowAndColToIndex(row, column)];
+	}
 
-	constexpr const T& operator()(size_t row, size_t column) const { return fArray[rowAndColToIndex(row, column)]; }
+	constexpr const T& operator()(size_t row, size_t column) const
+	{
+		updateIfNeeded();
+		return fArray[rowAndColToIndex(row, column)];
+	}
 
 	// Checked Access
 	constexpr std::optional<T &>
@@ -71,6 +141,7 @@ public:
 		if (row > Rows || column > Columns)
 			return {};
 
+		updateIfNeeded();
 		return fArray[rowAndColToIndex(row, column)];
 	}
 
@@ -80,6 +151,7 @@ public:
 		if (index >= Size)
 			return {};
 
+		updateIfNeeded();
 		return fArray[index];
 	}
 
@@ -96,12 +168,7 @@ public:
 	constexpr void
 	Reset()
 	{
-		fScaleX = 1.f;
-		fScaleY = 1.f;
-		fTranslateX = 0.f;
-		fTranslateY = 0.f;
-		fRotation = 0.f;
-
+		resetTransforms();
 		Identity();
 	}
 
@@ -113,14 +180,14 @@ public:
 		fScaleX += factor;
 		fScaleY += factor;
 
-		ApplyTransforms();
+		invalidateTransforms();
 	}
 
 	constexpr void
 	ScaleXBy(const T& factor)
 	{
 		fScaleX += factor;
-		ApplyTransforms();
+		invalidateTransforms();
 	}
 
 	constexpr void
@@ -128,7 +195,7 @@ public:
 	requires(Dimensions >= 2)
 	{
 		fScaleY += factor;
-		ApplyTransforms();
+		invalidateTransforms();
 	}
 
 //	void
@@ -144,37 +211,37 @@ public:
 
 
 	/** Rotate */
-	void
+	constexpr void
 	Rotate2DBy(const T& radians)
 	requires(Dimensions >= 2)
 	{
 		fRotation += radians;
-		ApplyTransforms();
+		invalidateTransforms();
 	}
 
 	/** Translate */
-	void
+	constexpr void
 	TranslateUniformBy(const T& offset)
 	{
 		fTranslateX += offset;
 		fTranslateY += offset;
-		ApplyTransforms();
+		invalidateTransforms();
 	}
 
-	void
+	constexpr void
 	TranslateXBy(const T& offset)
 	requires(Dimensions >= 3)
 	{
 		fTranslateX += offset;
-		ApplyTransforms();
+		invalidateTransforms();
 	}
 
-	void
+	constexpr void
 	TranslateYBy(const T& offset)
 	requires(Dimensions >= 3)
 	{
 		fTranslateY += offset;
-		ApplyTransforms();
+		invalidateTransforms();
 	}
 
 //	void
@@ -189,68 +256,38 @@ public:
 
 	// Matrix Multiplication
 
-	void
+	constexpr void
 	MultiplyBy(const std::array<T, Size>& other)
 	{
-		Matrix<T, Dimensions> matrixC;
-		for (size_t row = 0; row < Dimensions; row++) {
-			for (size_t column = 0; column < Dimensions; column++) {
-				matrixC(row, column) = 0;
-				for (size_t calcOffset = 0; calcOffset < Dimensions; calcOffset++) {
-					matrixC(row, column) += (this->operator()(row, calcOffset) *
-											 other[rowAndColToIndex(calcOffset, column)]);
-				}
-			}
-		}
-
-		fArray = matrixC.fArray;
+		multiplyBy(other.data());
 	}
 
 
-	void
+	constexpr void
 	MultiplyBy(const Matrix& other)
 	requires(Rows == other.Columns)
 	{
-		Matrix<T, Dimensions> matrixC;
-		for (size_t row = 0; row < Dimensions; row++) {
-			for (size_t column = 0; column < Dimensions; column++) {
-				matrixC(row, column) = 0;
-				for (size_t calcOffset = 0; calcOffset < Dimensions; calcOffset++) {
-					matrixC(row, column) += (this->operator()(row, calcOffset) *
-											 other[rowAndColToIndex(calcOffset, column)]);
-				}
-			}
-		}
-
-		fArray = matrixC.fArray;
+		multiplyBy(other);
 	}
 
 
-	Matrix&
+	constexpr Matrix&
 	operator*=(const Matrix& other)
 	requires(Columns == other.Rows)
 	{
-		Matrix<T, Dimensions> matrixC;
-		for (size_t row = 0; row < Dimensions; row++) {
-			for (size_t column = 0; column < Dimensions; column++) {
-				matrixC(row, column) = 0;
-				for (size_t calcOffset = 0; calcOffset < Dimensions; calcOffset++) {
-					matrixC(row, column) += (this->operator()(row, calcOffset) *
-											 other[rowAndColToIndex(calcOffset, column)]);
-				}
-			}
-		}
-
-		return std::move(matrixC);
+		multiplyBy(other);
+		return *this;
 	}
 
 
 	// When dealing with a 4x4 matrix, we assume w is implicitly 1
 	// when multiplying against a 3-coordinate vector (x, y, z).
-	Matrix&
+	constexpr Matrix&
 	operator*=(const Vector3D<T>& other)
 	requires(Dimensions == 3 || Dimensions == 4)
 	{
+		updateIfNeeded();
+
 		fArray[0] *= other.dx;
 		fArray[1] *= other.dy;
 		fArray[2] *= other.dz;
@@ -266,10 +303,178 @@ public:
 		return *this;
 	}
 
+
+	/** Inverse */
+
+	// Description: Inverts the 2D affine transform held at 0, 1, 4, 5, 12 and 13,
+	// which is everything the TRS interface produces. Works from the composed
+	// coefficients, so it stays valid after MultiplyBy() and needs no trig.
+	// 	- Returns nothing when the transform is singular.
+	[[nodiscard]] constexpr std::optional<Matrix>
+	AffineInverse() const
+	requires(Dimensions == 4)
+	{
+		updateIfNeeded();
+
+		const T a = fArray[0], b = fArray[1];
+		const T c = fArray[Dimensions], d = fArray[Dimensions + 1];
+		const T determinant = (a * d) - (b * c);
+		if (determinant == 0)
+			return {};
+
+		const T inverseDeterminant = 1 / determinant;
+
+		Matrix inverse;
+		inverse.fArray[0] = d * inverseDeterminant;
+		inverse.fArray[1] = -b * inverseDeterminant;
+		inverse.fArray[Dimensions] = -c * inverseDeterminant;
+		inverse.fArray[Dimensions + 1] = a * inverseDeterminant;
+		inverse.fArray[kTranslateX] = -((inverse.fArray[0] * fArray[kTranslateX])
+			+ (inverse.fArray[Dimensions] * fArray[kTranslateY]));
+		inverse.fArray[kTranslateY] = -((inverse.fArray[1] * fArray[kTranslateX])
+			+ (inverse.fArray[Dimensions + 1] * fArray[kTranslateY]));
+
+		return inverse;
+	}
+
+	// Description: Inverts the full matrix, by cofactor expansion for 4x4 and
+	// Gauss-Jordan elimination with partial pivoting otherwise.
+	// 	- Returns nothing when the matrix is singular.
+	[[nodiscard]] constexpr std::optional<Matrix>
+	Inverse() const
+	{
+		updateIfNeeded();
+
+		Matrix inverse;
+		if constexpr (Dimensions == 4) {
+			if (!invert4x4(fArray.data(), inverse.fArray.data()))
+				return {};
+		} else {
+			if (!invertGaussJordan(fArray, inverse.fArray))
+				return {};
+		}
+
+		return inverse;
+	}
+
+
+	/** Decomposition */
+
+	struct Transforms {
+		T scaleX;
+		T scaleY;
+		T rotation;
+		T translateX;
+		T translateY;
+	};
+
+	// Description: Recovers scale, rotation and translation from the composed
+	// 2D affine coefficients (any shear is dropped).
+	// 	- scaleX comes back non-negative; a reflection shows up as a negative scaleY.
+	[[nodiscard]] Transforms
+	Decompose() const
+	requires(Dimensions == 4)
+	{
+		updateIfNeeded();
+
+		const T a = fArray[0], b = fArray[1];
+		const T c = fArray[Dimensions], d = fArray[Dimensions + 1];
+
+		Transforms transforms{};
+		transforms.scaleX = std::hypot(a, b);
+		transforms.rotation = std::atan2(-b, a);
+
+		// Project the Y axis onto the rotated frame
+		transforms.scaleY = (c * std::sin(transforms.rotation)) + (d * std::cos(transforms.rotation));
+		transforms.translateX = fArray[kTranslateX];
+		transforms.translateY = fArray[kTranslateY];
+		return transforms;
+	}
+
+	// Description: Replaces the TRS parameters, e.g. with the result of Decompose().
+	constexpr void
+	SetTransforms(const Transforms& transforms)
+	{
+		fScaleX = transforms.scaleX;
+		fScaleY = transforms.scaleY;
+		fRotation = transforms.rotation;
+		fTranslateX = transforms.translateX;
+		fTranslateY = transforms.translateY;
+
+		invalidateTransforms();
+	}
+
+	[[nodiscard]] constexpr Transforms
+	GetTransforms() const
+	{
+		return {fScaleX, fScaleY, fRotation, fTranslateX, fTranslateY};
+	}
+
+	// Description: The most this transform stretches any 2D direction, i.e.
+	// the larger singular value of its 2x2 linear part (shear included).
+	[[nodiscard]] T
+	MaxScale() const
+	requires(Dimensions == 4)
+	{
+		updateIfNeeded();
+		return MaxScale2x2(fArray[0], fArray[1], fArray[Dimensions], fArray[Dimensions + 1]);
+	}
+
+	[[nodiscard]] static T
+	MaxScale2x2(T a, T b, T c, T d)
+	{
+		const T sumOfSquares = (a * a) + (b * b) + (c * c) + (d * d);
+		const T determinant = (a * d) - (b * c);
+		const T discriminant = std::max<T>((sumOfSquares * sumOfSquares) - (4 * determinant * determinant), 0);
+		return std::sqrt((sumOfSquares + std::sqrt(discriminant)) / 2);
+	}
+
 private:
-	constexpr size_t rowAndColToIndex(size_t row, size_t column) { return (row * Columns) + column; }
+	// The TRS parameters are only composed into fArray once the matrix
+	// is read, so any number of edits between two reads costs a single
+	// ApplyTransforms().
+	//
+	// A const read of a dirty matrix composes through the const_cast below,
+	// which is undefined behavior if the matrix object itself is const.
+	// Copies are composed as they are made, but a const Matrix initialized
+	// straight from a dirty prvalue (say a local edited with Rotate2DBy()
+	// and returned with NRVO) is not. Call ApplyTransforms() before returning
+	// an edited matrix by value. fArray can't be 'mutable' instead, because a
+	// mutable member isn't readable in a constant expression.
+	constexpr void invalidateTransforms() { fNeedsUpdate = true; }
 
-	void
+	constexpr void
+	resetTransforms()
+	{
+		fScaleX = 1.f;
+		fScaleY = 1.f;
+		fTranslateX = 0.f;
+		fTranslateY = 0.f;
+		fRotation = 0.f;
+
+		fNeedsUpdate = false;
+	}
+
+	constexpr void
+	updateIfNeeded() const
+	{
+		if (fNeedsUpdate)
+			const_cast<Matrix*>(this)->ApplyTransforms();
+	}
+
+	static constexpr size_t rowAndColToIndex(size_t row, size_t column) { return (row * Columns) + column; }
+
+	constexpr void
+	multiplyBy(const T* other)
+	{
+		updateIfNeeded();
+
+		std::array<T, Size> product;
+		MatrixKernels::Multiply<T, Dimensions>(fArray.data(), other, product.data());
+		fArray = product;
+	}
+
+	constexpr void
 	doScaleX(T factor)
 	{
 		if (factor == 0)
@@ -281,7 +486,7 @@ private:
 		this->MultiplyBy(scaleMatrix);
 	}
 
-	void
+	constexpr void
 	doScaleY(T factor)
 	{
 		if (factor == 0)
@@ -294,9 +499,39 @@ private:
 	}
 
 
-	static constexpr const size_t kTranslateX = 12;
+	// Closed form of the scale * rotation * translation product built by
+	// the doScale/doRotate/doTranslate chain: only six coefficients of a
+	// 2D affine transform are meaningful, so write them directly.
+	constexpr void
+	composeAffine2D()
+	requires(Dimensions == 4)
+	{
+		// The generic path skips a zero factor, so treat it as 1 here too
+		const T scaleX = (fScaleX == 0) ? 1 : fScaleX;
+		const T scaleY = (fScaleY == 0) ? 1 : fScaleY;
+
+		// Adjacent sin/cos of the same argument get folded into one sincos call
+		T cosRads = 1;
+		T sinRads = 0;
+		if (fRotation != 0) {
+			cosRads = ConstexprMath::Cos<T>(fRotation);
+			sinRads = ConstexprMath::Sin<T>(fRotation);
+		}
+
+		Identity();
+		fArray[0] = scaleX * cosRads;
+		fArray[1] = scaleX * -sinRads;
+		fArray[Dimensions] = scaleY * sinRads;
+		fArray[Dimensions + 1] = scaleY * cosRads;
+		fArray[kTranslateX] = fTranslateX;
+		fArray[kTranslateY] = fTranslateY;
+	}
+
+
+	// The last row holds the translation (12 and 13 for a 4x4 matrix)
+	static constexpr const size_t kTranslateX = Dimensions * (Dimensions - 1);
 
-	void
+	constexpr void
 	doTranslateX(T offset)
 	{
 		if (offset == 0)
@@ -309,9 +544,9 @@ private:
 	}
 
 
-	static constexpr const size_t kTranslateY = 13;
+	static constexpr const size_t kTranslateY = kTranslateX + 1;
 
-	void
+	constexpr void
 	doTranslateY(T offset)
 	{
 		if (offset == 0)
@@ -323,29 +558,121 @@ private:
 		this->MultiplyBy(translateMatrix);
 	}
 
-	void
+	constexpr void
 	doRotate2D(T radians)
 	{
 		if (radians == 0)
 			return;
 
-		double cosRads = std::cos(radians);
-		double sinRads = std::sin(radians);
+		const T cosRads = ConstexprMath::Cos(radians);
+		const T sinRads = ConstexprMath::Sin(radians);
 
 		// Rotate around Z-axis
-		std::array<T, Size> rotationArray = {
-			cosRads,	-1 * sinRads,	0,	0,
-			sinRads,	cosRads,		0,	0,
-			0,			0,				1,	0,
-			0,			0,				0,	1
-		};
+		Matrix<T, Dimensions> rotationMatrix;
+		rotationMatrix[0] = cosRads;
+		rotationMatrix[1] = -1 * sinRads;
+		rotationMatrix[Dimensions] = sinRads;
+		rotationMatrix[Dimensions + 1] = cosRads;
 
-		this->MultiplyBy(rotationArray);
+		this->MultiplyBy(rotationMatrix);
+	}
+
+	static constexpr bool
+	invert4x4(const T* m, T* inverse)
+	{
+		inverse[0] = m[5] * m[10] * m[15] - m[5] * m[11] * m[14] - m[9] * m[6] * m[15]
+			+ m[9] * m[7] * m[14] + m[13] * m[6] * m[11] - m[13] * m[7] * m[10];
+		inverse[4] = -m[4] * m[10] * m[15] + m[4] * m[11] * m[14] + m[8] * m[6] * m[15]
+			- m[8] * m[7] * m[14] - m[12] * m[6] * m[11] + m[12] * m[7] * m[10];
+		inverse[8] = m[4] * m[9] * m[15] - m[4] * m[11] * m[13] - m[8] * m[5] * m[15]
+			+ m[8] * m[7] * m[13] + m[12] * m[5] * m[11] - m[12] * m[7] * m[9];
+		inverse[12] = -m[4] * m[9] * m[14] + m[4] * m[10] * m[13] + m[8] * m[5] * m[14]
+			- m[8] * m[6] * m[13] - m[12] * m[5] * m[10] + m[12] * m[6] * m[9];
+
+		const T determinant = m[0] * inverse[0] + m[1] * inverse[4] + m[2] * inverse[8] + m[3] * inverse[12];
+		if (determinant == 0)
+			return false;
+
+		inverse[1] = -m[1] * m[10] * m[15] + m[1] * m[11] * m[14] + m[9] * m[2] * m[15]
+			- m[9] * m[3] * m[14] - m[13] * m[2] * m[11] + m[13] * m[3] * m[10];
+		inverse[5] = m[0] * m[10] * m[15] - m[0] * m[11] * m[14] - m[8] * m[2] * m[15]
+			+ m[8] * m[3] * m[14] + m[12] * m[2] * m[11] - m[12] * m[3] * m[10];
+		inverse[9] = -m[0] * m[9] * m[15] + m[0] * m[11] * m[13] + m[8] * m[1] * m[15]
+			- m[8] * m[3] * m[13] - m[12] * m[1] * m[11] + m[12] * m[3] * m[9];
+		inverse[13] = m[0] * m[9] * m[14] - m[0] * m[10] * m[13] - m[8] * m[1] * m[14]
+			+ m[8] * m[2] * m[13] + m[12] * m[1] * m[10] - m[12] * m[2] * m[9];
+		inverse[2] = m[1] * m[6] * m[15] - m[1] * m[7] * m[14] - m[5] * m[2] * m[15]
+			+ m[5] * m[3] * m[14] + m[13] * m[2] * m[7] - m[13] * m[3] * m[6];
+		inverse[6] = -m[0] * m[6] * m[15] + m[0] * m[7] * m[14] + m[4] * m[2] * m[15]
+			- m[4] * m[3] * m[14] - m[12] * m[2] * m[7] + m[12] * m[3] * m[6];
+		inverse[10] = m[0] * m[5] * m[15] - m[0] * m[7] * m[13] - m[4] * m[1] * m[15]
+			+ m[4] * m[3] * m[13] + m[12] * m[1] * m[7] - m[12] * m[3] * m[5];
+		inverse[14] = -m[0] * m[5] * m[14] + m[0] * m[6] * m[13] + m[4] * m[1] * m[14]
+			- m[4] * m[2] * m[13] - m[12] * m[1] * m[6] + m[12] * m[2] * m[5];
+		inverse[3] = -m[1] * m[6] * m[11] + m[1] * m[7] * m[10] + m[5] * m[2] * m[11]
+			- m[5] * m[3] * m[10] - m[9] * m[2] * m[7] + m[9] * m[3] * m[6];
+		inverse[7] = m[0] * m[6] * m[11] - m[0] * m[7] * m[10] - m[4] * m[2] * m[11]
+			+ m[4] * m[3] * m[10] + m[8] * m[2] * m[7] - m[8] * m[3] * m[6];
+		inverse[11] = -m[0] * m[5] * m[11] + m[0] * m[7] * m[9] + m[4] * m[1] * m[11]
+			- m[4] * m[3] * m[9] - m[8] * m[1] * m[7] + m[8] * m[3] * m[5];
+		inverse[15] = m[0] * m[5] * m[10] - m[0] * m[6] * m[9] - m[4] * m[1] * m[10]
+			+ m[4] * m[2] * m[9] + m[8] * m[1] * m[6] - m[8] * m[2] * m[5];
+
+		const T inverseDeterminant = 1 / determinant;
+		for (size_t index = 0; index < Size; index++)
+			inverse[index] *= inverseDeterminant;
+
+		return true;
+	}
+
+	static constexpr bool
+	invertGaussJordan(std::array<T, Size> work, std::array<T, Size>& inverse)
+	{
+		// 'inverse' starts out as the identity
+		for (size_t pivot = 0; pivot < Dimensions; pivot++) {
+			size_t bestRow = pivot;
+			for (size_t row = pivot + 1; row < Dimensions; row++) {
+				const T candidate = work[rowAndColToIndex(row, pivot)];
+				const T best = work[rowAndColToIndex(bestRow, pivot)];
+				if ((candidate < 0 ? -candidate : candidate) > (best < 0 ? -best : best))
+					bestRow = row;
+			}
+
+			if (work[rowAndColToIndex(bestRow, pivot)] == 0)
+				return false;
+
+			if (bestRow != pivot) {
+				for (size_t column = 0; column < Dimensions; column++) {
+					std::swap(work[rowAndColToIndex(pivot, column)], work[rowAndColToIndex(bestRow, column)]);
+					std::swap(inverse[rowAndColToIndex(pivot, column)], inverse[rowAndColToIndex(bestRow, column)]);
+				}
+			}
+
+			const T scale = 1 / work[rowAndColToIndex(pivot, pivot)];
+			for (size_t column = 0; column < Dimensions; column++) {
+				work[rowAndColToIndex(pivot, column)] *= scale;
+				inverse[rowAndColToIndex(pivot, column)] *= scale;
+			}
+
+			for (size_t row = 0; row < Dimensions; row++) {
+				const T factor = work[rowAndColToIndex(row, pivot)];
+				if (row == pivot || factor == 0)
+					continue;
+
+				for (size_t column = 0; column < Dimensions; column++) {
+					work[rowAndColToIndex(row, column)] -= factor * work[rowAndColToIndex(pivot, column)];
+					inverse[rowAndColToIndex(row, column)] -= factor * inverse[rowAndColToIndex(pivot, column)];
+				}
+			}
+		}
+
+		return true;
 	}
 
 private:
 	// Underlying Array
 	std::array<T, Size> fArray;
+	bool fNeedsUpdate = false;
 
 	float fScaleX = 1.f;
 	float fScaleY = 1.f;
@@ -370,25 +697,6 @@ operator<<(std::ostream& out, const Matrix<T, Dimensions>& matrix)
 	return out;
 }
 
-// This only works with matrices of the same size for now...
-template<typename T, size_t Dimensions>
-static Matrix<T, Dimensions>
-operator*(const Matrix<T, Dimensions>& matrixA, const Matrix<T, Dimensions>& matrixB)
-{
-	Matrix<T, Dimensions> matrixC;
-	for (size_t row = 0; row < Dimensions; row++) {
-		for (size_t column = 0; column < Dimensions; column++) {
-			matrixC(row, column) = 0;
-			for (size_t calcOffset = 0; calcOffset < Dimensions; calcOffset++) {
-				matrixC(row, column) += (matrixA(row, calcOffset) * matrixB(calcOffset, column));
-			}
-		}
-	}
-
-	return matrixC;
-}
-
-
 /** Types */
 template<typename T>
 using Matrix2D = Matrix<T, 2>;
@@ -0,0 +1,160 @@
+// Assignment 2a - Programming Interactive 2D Graphics with OpenGL
+// Work by Jacob Secunda
+#ifndef HW2A_MATRIXKERNELS_HPP
+#define HW2A_MATRIXKERNELS_HPP
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define HW2A_HAVE_SSE2 1
+#include <emmintrin.h>
+#endif
+
+// Configure with -DHW2A_ENABLE_AVX=ON to build for AVX
+#if defined(__AVX__)
+#define HW2A_HAVE_AVX 1
+#include <immintrin.h>
+#endif
+
+// Row-major square matrix products: out = a * b
+//
+// 'out' must not alias 'a' or 'b'.
+//
+// Accuracy: every SIMD kernel accumulates a(row, 0) * b(0, column) + ... +
+// a(row, 3) * b(3, column) in the same order as the scalar loop, with
+// separate multiplies and adds (no FMA), so results are bitwise identical to
+// MultiplyScalar (0 ULP). The only difference is the sign of an exact zero
+// result, since the scalar loop starts its sum from +0. This bound assumes the
+// scalar loop is not contracted into FMAs (e.g. -mfma with GCC's default
+// -ffp-contract=fast); in that case each element may differ by the rounding
+// of its three intermediate sums.
+namespace MatrixKernels {
+
+namespace detail {
+
+// sum(a(row, k) * b(k, column)) for k = 0..Dimensions-1, accumulated left to right
+template<typename T, size_t Dimensions, size_t... Offsets>
+constexpr T
+DotRowColumn(const T* a, const T* b, size_t row, size_t column, std::index_sequence<Offsets...>)
+{
+	return (T(0) + ... + (a[(row * Dimensions) + Offsets] * b[(Offsets * Dimensions) + column]));
+}
+
+
+template<typename T, size_t Dimensions, size_t... Indices>
+constexpr void
+MultiplyUnrolled(const T* a, const T* b, T* out, std::index_sequence<Indices...>)
+{
+	((out[Indices] = DotRowColumn<T, Dimensions>(a, b, Indices / Dimensions, Indices % Dimensions,
+		std::make_index_sequence<Dimensions>())), ...);
+}
+
+} // namespace detail
+
+
+// Fully unrolled at compile time from 'Dimensions'
+template<typename T, size_t Dimensions>
+constexpr void
+MultiplyScalar(const T* a, const T* b, T* out)
+{
+	detail::MultiplyUnrolled<T, Dimensions>(a, b, out, std::make_index_sequence<Dimensions * Dimensions>());
+}
+
+
+#if HW2A_HAVE_AVX
+// Two output rows per iteration, with each row of 'b' broadcast to both lanes
+inline void
+Multiply4x4(const float* a, const float* b, float* out)
+{
+	const __m256 bRow0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(b));
+	const __m256 bRow1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(b + 4));
+	const __m256 bRow2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(b + 8));
+	const __m256 bRow3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(b + 12));
+
+	for (size_t row = 0; row < 4; row += 2) {
+		const float* aRows = a + (row * 4);
+
+		__m256 sum = _mm256_mul_ps(_mm256_setr_m128(_mm_set1_ps(aRows[0]), _mm_set1_ps(aRows[4])), bRow0);
+		sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_setr_m128(_mm_set1_ps(aRows[1]), _mm_set1_ps(aRows[5])), bRow1));
+		sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_setr_m128(_mm_set1_ps(aRows[2]), _mm_set1_ps(aRows[6])), bRow2));
+		sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_setr_m128(_mm_set1_ps(aRows[3]), _mm_set1_ps(aRows[7])), bRow3));
+
+		_mm256_storeu_ps(out + (row * 4), sum);
+	}
+}
+
+
+inline void
+Multiply4x4(const double* a, const double* b, double* out)
+{
+	const __m256d bRow0 = _mm256_loadu_pd(b);
+	const __m256d bRow1 = _mm256_loadu_pd(b + 4);
+	const __m256d bRow2 = _mm256_loadu_pd(b + 8);
+	const __m256d bRow3 = _mm256_loadu_pd(b + 12);
+
+	for (size_t row = 0; row < 4; row++) {
+		const double* aRow = a + (row * 4);
+
+		__m256d sum = _mm256_mul_pd(_mm256_set1_pd(aRow[0]), bRow0);
+		sum = _mm256_add_pd(sum, _mm256_mul_pd(_mm256_set1_pd(aRow[1]), bRow1));
+		sum = _mm256_add_pd(sum, _mm256_mul_pd(_mm256_set1_pd(aRow[2]), bRow2));
+		sum = _mm256_add_pd(sum, _mm256_mul_pd(_mm256_set1_pd(aRow[3]), bRow3));
+
+		_mm256_storeu_pd(out + (row * 4), sum);
+	}
+}
+#elif HW2A_HAVE_SSE2
+inline void
+Multiply4x4(const float* a, const float* b, float* out)
+{
+	const __m128 bRow0 = _mm_loadu_ps(b);
+	const __m128 bRow1 = _mm_loadu_ps(b + 4);
+	const __m128 bRow2 = _mm_loadu_ps(b + 8);
+	const __m128 bRow3 = _mm_loadu_ps(b + 12);
+
+	for (size_t row = 0; row < 4; row++) {
+		const float* aRow = a + (row * 4);
+
+		__m128 sum = _mm_mul_ps(_mm_set1_ps(aRow[0]), bRow0);
+		sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(aRow[1]), bRow1));
+		sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(aRow[2]), bRow2));
+		sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(aRow[3]), bRow3));
+
+		_mm_storeu_ps(out + (row * 4), sum);
+	}
+}
+#endif
+
+
+// Picks the widest kernel available for the build target, else the scalar loop.
+// Constant evaluation always takes the scalar loop.
+template<typename T, size_t Dimensions>
+constexpr void
+Multiply(const T* a, const T* b, T* out)
+{
+	if (std::is_constant_evaluated()) {
+		MultiplyScalar<T, Dimensions>(a, b, out);
+		return;
+	}
+
+#if HW2A_HAVE_AVX
+	if constexpr (Dimensions == 4 && (std::is_same_v<T, float> || std::is_same_v<T, double>)) {
+		Multiply4x4(a, b, out);
+		return;
+	}
+#elif HW2A_HAVE_SSE2
+	if constexpr (Dimensions == 4 && std::is_same_v<T, float>) {
+		Multiply4x4(a, b, out);
+		return;
+	}
+#endif
+
+	MultiplyScalar<T, Dimensions>(a, b, out);
+}
+
+} // namespace MatrixKernels
+
+
+#endif //HW2A_MATRIXKERNELS_HPP
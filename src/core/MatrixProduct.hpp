@@ -0,0 +1,126 @@
+// Assignment 2a - Programming Interactive 2D Graphics with OpenGL
+// Work by Jacob Secunda
+#ifndef HW2A_MATRIXPRODUCT_HPP
+#define HW2A_MATRIXPRODUCT_HPP
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+
+#include "MatrixKernels.hpp"
+
+template<typename T, size_t Dimensions>
+requires(Dimensions > 0)
+struct Matrix;
+
+template<typename Left, typename Right>
+class MatrixProduct;
+
+
+/** Operand Traits */
+
+// Matrices are referenced by a product, nested products are held by value.
+template<typename Operand>
+struct MatrixOperandTraits;
+
+template<typename T, size_t N>
+struct MatrixOperandTraits<Matrix<T, N>> {
+	using ValueType = T;
+	static constexpr size_t Dimensions = N;
+	using Storage = const Matrix<T, N>&;
+};
+
+template<typename Left, typename Right>
+struct MatrixOperandTraits<MatrixProduct<Left, Right>> {
+	using ValueType = typename MatrixOperandTraits<Left>::ValueType;
+	static constexpr size_t Dimensions = MatrixOperandTraits<Left>::Dimensions;
+	using Storage = const MatrixProduct<Left, Right>;
+};
+
+template<typename Operand>
+concept MatrixOperand = requires { typename MatrixOperandTraits<Operand>::ValueType; };
+
+
+/** Lazy Product */
+
+// A * B * C builds a tree of MatrixProducts instead of intermediate matrices.
+// Assigning it to a Matrix multiplies each pair exactly once, straight from
+// the operands' storage, with uninitialized stack scratch for nested results
+// and the final product written directly into the destination.
+//
+// Expressions reference their matrix operands, so evaluate them within the
+// full-expression that builds them instead of storing them with 'auto'.
+template<typename Left, typename Right>
+class MatrixProduct {
+public:
+	using ValueType = typename MatrixOperandTraits<Left>::ValueType;
+	static constexpr size_t Dimensions = MatrixOperandTraits<Left>::Dimensions;
+	static constexpr size_t Size = Dimensions * Dimensions;
+
+	static_assert(std::is_same_v<ValueType, typename MatrixOperandTraits<Right>::ValueType>);
+	static_assert(Dimensions == MatrixOperandTraits<Right>::Dimensions);
+
+	constexpr MatrixProduct(const Left& left, const Right& right)
+		:
+		fLeft(left),
+		fRight(right)
+	{
+	}
+
+	// Description: Writes the product to 'out', which must not be storage of any operand.
+	constexpr void
+	EvaluateInto(ValueType* out) const
+	{
+		std::array<ValueType, Size> leftScratch;
+		std::array<ValueType, Size> rightScratch;
+
+		MatrixKernels::Multiply<ValueType, Dimensions>(resolve(fLeft, leftScratch.data()),
+			resolve(fRight, rightScratch.data()), out);
+	}
+
+	// Description: Checks whether 'matrix' is one of the operands of this product.
+	[[nodiscard]] constexpr bool
+	References(const void* matrix) const
+	{
+		return references(fLeft, matrix) || references(fRight, matrix);
+	}
+
+private:
+	template<typename Operand>
+	static constexpr const ValueType*
+	resolve(const Operand& operand, ValueType* scratch)
+	{
+		if constexpr (std::is_same_v<Operand, Matrix<ValueType, Dimensions>>) {
+			return operand;
+		} else {
+			operand.EvaluateInto(scratch);
+			return scratch;
+		}
+	}
+
+	template<typename Operand>
+	static constexpr bool
+	references(const Operand& operand, const void* matrix)
+	{
+		if constexpr (std::is_same_v<Operand, Matrix<ValueType, Dimensions>>)
+			return &operand == matrix;
+		else
+			return operand.References(matrix);
+	}
+
+private:
+	typename MatrixOperandTraits<Left>::Storage fLeft;
+	typename MatrixOperandTraits<Right>::Storage fRight;
+};
+
+
+// This only works with matrices of the same size for now...
+template<MatrixOperand Left, MatrixOperand Right>
+constexpr MatrixProduct<Left, Right>
+operator*(const Left& left, const Right& right)
+{
+	return {left, right};
+}
+
+
+#endif //HW2A_MATRIXPRODUCT_HPP
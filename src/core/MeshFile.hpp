@@ -0,0 +1,386 @@
+// Assignment 2a - Programming Interactive 2D Graphics with OpenGL
+// Work by Jacob Secunda
+#ifndef HW2A_MESHFILE_HPP
+#define HW2A_MESHFILE_HPP
+
+#include "glad/glad.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <span>
+#include <vector>
+
+#include "MappedFile.hpp"
+
+// A versioned binary mesh container, laid out so that its vertex and index
+// blobs can go from the page cache to the GPU without being touched:
+//
+// | Header | AttributeDescriptor * attributeCount | pad | vertex blob | pad | index blob | pad | levels |
+//
+// 	- All fields are little-endian; blobs start on kBlobAlignment boundaries.
+// 	- Attribute descriptors map directly onto glVertexAttribPointer().
+// 	- Levels of detail (since 1.1) are ranges of the index blob, see MeshLOD.hpp.
+// 	- A reader accepts any minor version of its major version: minor versions
+// 	  may only append fields to the header, which headerSize accounts for.
+// 	  Fields a file's header doesn't reach read as 0.
+namespace MeshFile {
+
+static constexpr char kMagic[4] = {'H', 'W', '2', 'M'};
+static constexpr uint16_t kVersionMajor = 1;
+static constexpr uint16_t kVersionMinor = 1;
+
+static constexpr uint64_t kBlobAlignment = 64;
+static constexpr uint32_t kMaxAttributes = 16;
+static constexpr uint32_t kMaxLevels = 64;
+
+// Which shader input an attribute feeds
+enum class Semantic : uint32_t {
+	kPosition = 0,
+	kColor = 1
+};
+
+struct Header {
+	char magic[4];
+	uint16_t versionMajor;
+	uint16_t versionMinor;
+	uint32_t headerSize;		// offset of the first attribute descriptor
+	uint32_t attributeCount;
+	uint32_t vertexCount;
+	uint32_t indexCount;		// 0 for a non-indexed mesh
+	uint32_t indexType;		// GL_UNSIGNED_SHORT or GL_UNSIGNED_INT, 0 without indices
+	uint32_t primitive;		// GL_TRIANGLES
+	uint64_t vertexDataOffset;
+	uint64_t vertexDataSize;
+	uint64_t indexDataOffset;
+	uint64_t indexDataSize;
+	// 1.1
+	uint32_t levelCount;		// 0 without levels of detail
+	uint32_t reserved;
+	uint64_t levelDataOffset;
+};
+static_assert(sizeof(Header) == 80);
+
+// The header of a 1.0 file, which ends before levelCount
+static constexpr uint32_t kMinHeaderSize = 64;
+
+struct AttributeDescriptor {
+	uint32_t semantic;		// a Semantic
+	uint32_t componentCount;	// 1 to 4
+	uint32_t componentType;	// GL_FLOAT, GL_UNSIGNED_BYTE, ...
+	uint32_t normalized;		// GL_TRUE or GL_FALSE
+	uint32_t offset;		// from the start of the vertex blob
+	uint32_t stride;		// 0 when tightly packed
+};
+static_assert(sizeof(AttributeDescriptor) == 24);
+
+// A level of detail: 'indexCount' indices from 'firstIndex' on, drawn while
+// its 'error' (in model units) stays under a pixel
+struct LevelDescriptor {
+	uint32_t firstIndex;
+	uint32_t indexCount;
+	float error;
+	uint32_t reserved;
+};
+static_assert(sizeof(LevelDescriptor) == 16);
+
+static constexpr uint64_t
+AlignUp(uint64_t value)
+{
+	return (value + (kBlobAlignment - 1)) & ~(kBlobAlignment - 1);
+}
+
+static constexpr uint32_t
+IndexSize(uint32_t indexType)
+{
+	switch (indexType) {
+		case GL_UNSIGNED_SHORT:
+			return sizeof(uint16_t);
+		case GL_UNSIGNED_INT:
+			return sizeof(uint32_t);
+		default:
+			return 0;
+	}
+}
+
+static constexpr uint32_t
+ComponentSize(uint32_t componentType)
+{
+	switch (componentType) {
+		case GL_BYTE:
+		case GL_UNSIGNED_BYTE:
+			return 1;
+		case GL_SHORT:
+		case GL_UNSIGNED_SHORT:
+		case GL_HALF_FLOAT:
+			return 2;
+		case GL_INT:
+		case GL_UNSIGNED_INT:
+		case GL_FLOAT:
+			return 4;
+		case GL_DOUBLE:
+			return 8;
+		default:
+			return 0;
+	}
+}
+
+
+// Description: Writes a mesh file.
+// 	- 'vertexData' is stored verbatim; 'attributes' describe its layout.
+// 	- Pass an empty 'indexData' and 0 for 'indexType' for a non-indexed mesh.
+// 	- 'levels' are ranges of 'indexData', the full mesh first.
+static inline bool
+Write(const char* path, uint32_t vertexCount, std::span<const AttributeDescriptor> attributes,
+	std::span<const std::byte> vertexData, uint32_t indexType = 0, std::span<const std::byte> indexData = {},
+	std::span<const LevelDescriptor> levels = {})
+{
+	if (attributes.size() > kMaxAttributes) {
+		printf("too many attributes (%zu) for mesh file %s\n", attributes.size(), path);
+		return false;
+	}
+
+	if (levels.size() > kMaxLevels || (!levels.empty() && indexData.empty())) {
+		printf("can't store %zu levels of detail in mesh file %s\n", levels.size(), path);
+		return false;
+	}
+
+	Header header{};
+	memcpy(header.magic, kMagic, sizeof(kMagic));
+	header.versionMajor = kVersionMajor;
+	header.versionMinor = kVersionMinor;
+	header.headerSize = sizeof(Header);
+	header.attributeCount = static_cast<uint32_t>(attributes.size());
+	header.vertexCount = vertexCount;
+	header.indexType = indexData.empty() ? 0 : indexType;
+	header.indexCount = indexData.empty() ? 0 : static_cast<uint32_t>(indexData.size() / IndexSize(indexType));
+	header.primitive = GL_TRIANGLES;
+	header.vertexDataOffset = AlignUp(sizeof(Header) + attributes.size_bytes());
+	header.vertexDataSize = vertexData.size();
+	header.indexDataOffset = indexData.empty() ? 0 : AlignUp(header.vertexDataOffset + header.vertexDataSize);
+	header.indexDataSize = indexData.size();
+	header.levelCount = static_cast<uint32_t>(levels.size());
+	header.levelDataOffset = levels.empty() ? 0 : AlignUp(header.indexDataOffset + header.indexDataSize);
+
+	FILE* file = fopen(path, "wb");
+	if (file == nullptr) {
+		printf("can't create mesh file %s\n", path);
+		return false;
+	}
+
+	static constexpr std::byte kPadding[kBlobAlignment] = {};
+	uint64_t position = 0;
+	bool succeeded = true;
+
+	const auto write = [&](const void* data, uint64_t size) {
+		if (succeeded && size > 0 && fwrite(data, 1, size, file) != size)
+			succeeded = false;
+		position += size;
+	};
+
+	const auto padTo = [&](uint64_t offset) {
+		write(kPadding, offset - position);
+	};
+
+	write(&header, sizeof(header));
+	write(attributes.data(), attributes.size_bytes());
+	padTo(header.vertexDataOffset);
+	write(vertexData.data(), vertexData.size());
+	if (!indexData.empty()) {
+		padTo(header.indexDataOffset);
+		write(indexData.data(), indexData.size());
+	}
+	if (!levels.empty()) {
+		padTo(header.levelDataOffset);
+		write(levels.data(), levels.size_bytes());
+	}
+
+	if (fclose(file) != 0)
+		succeeded = false;
+
+	if (!succeeded)
+		printf("can't write mesh file %s\n", path);
+
+	return succeeded;
+}
+
+
+// A mesh file mapped into memory. Open() checks the header, that every
+// attribute of every vertex lies inside the vertex blob, that every index
+// names a vertex, and that every level lies inside the indices. The vertex blob is not read until it is handed to the GPU.
+class MappedMesh {
+public:
+	// Description: Maps and validates the mesh file at 'path'.
+	// 	- Returns false, with a message, for a missing, truncated or
+	// 	  incompatible file.
+	bool
+	Open(const char* path)
+	{
+		Close();
+
+		if (!fFile.Open(path))
+			return false;
+
+		if (!validate()) {
+			printf("%s is not a compatible mesh file\n", path);
+			Close();
+			return false;
+		}
+
+		return true;
+	}
+
+	void
+	Close()
+	{
+		fFile.Close();
+		fHeader = {};
+		fAttributes.clear();
+		fLevels.clear();
+	}
+
+	[[nodiscard]] const Header& GetHeader() const { return fHeader; }
+
+	[[nodiscard]] std::span<const AttributeDescriptor> Attributes() const { return fAttributes; }
+
+	// Empty for a file without levels of detail
+	[[nodiscard]] std::span<const LevelDescriptor> Levels() const { return fLevels; }
+
+	[[nodiscard]] const void* VertexData() const { return fFile.Data() + fHeader.vertexDataOffset; }
+
+	[[nodiscard]] const void* IndexData() const { return fFile.Data() + fHeader.indexDataOffset; }
+
+private:
+	bool
+	validate()
+	{
+		const std::byte* data = fFile.Data();
+		const uint64_t size = fFile.Size();
+
+		if (size < kMinHeaderSize)
+			return false;
+
+		// The header and descriptors are copied out, everything else stays mapped.
+		// An older minor version's shorter header leaves the newer fields at 0.
+		fHeader = {};
+		memcpy(&fHeader, data, kMinHeaderSize);
+		if (memcmp(fHeader.magic, kMagic, sizeof(kMagic)) != 0 || fHeader.versionMajor != kVersionMajor)
+			return false;
+
+		if (fHeader.headerSize < kMinHeaderSize || fHeader.headerSize > size
+			|| fHeader.attributeCount > kMaxAttributes || fHeader.primitive != GL_TRIANGLES)
+			return false;
+
+		memcpy(&fHeader, data, std::min<uint64_t>(fHeader.headerSize, sizeof(Header)));
+
+		const uint64_t attributesEnd = fHeader.headerSize + (uint64_t(fHeader.attributeCount) * sizeof(AttributeDescriptor));
+		if (attributesEnd > size)
+			return false;
+
+		fAttributes.resize(fHeader.attributeCount);
+		memcpy(fAttributes.data(), data + fHeader.headerSize, fHeader.attributeCount * sizeof(AttributeDescriptor));
+
+		// Blobs must lie inside the file
+		if (fHeader.vertexDataOffset < attributesEnd || fHeader.vertexDataOffset > size
+			|| fHeader.vertexDataSize > size - fHeader.vertexDataOffset)
+			return false;
+
+		if (fHeader.indexCount > 0) {
+			const uint32_t indexSize = IndexSize(fHeader.indexType);
+			if (indexSize == 0 || fHeader.indexDataSize != uint64_t(fHeader.indexCount) * indexSize)
+				return false;
+
+			if (fHeader.indexDataOffset > size || fHeader.indexDataSize > size - fHeader.indexDataOffset)
+				return false;
+		}
+
+		// Every attribute of every vertex must lie inside the vertex blob
+		for (const AttributeDescriptor& attribute : fAttributes) {
+			const uint32_t componentSize = ComponentSize(attribute.componentType);
+			if (componentSize == 0 || attribute.componentCount < 1 || attribute.componentCount > 4)
+				return false;
+
+			const uint64_t elementSize = uint64_t(attribute.componentCount) * componentSize;
+			if (attribute.stride != 0 && attribute.offset + elementSize > attribute.stride)
+				return false;
+
+			const uint64_t stride = (attribute.stride != 0) ? attribute.stride : elementSize;
+			if (fHeader.vertexCount > 0
+				&& attribute.offset + (uint64_t(fHeader.vertexCount - 1) * stride) + elementSize > fHeader.vertexDataSize)
+				return false;
+		}
+
+		if (fHeader.indexCount > 0 && !validateIndices())
+			return false;
+
+		return validateLevels();
+	}
+
+	// Levels must be whole triangles inside the index blob
+	bool
+	validateLevels()
+	{
+		if (fHeader.levelCount == 0)
+			return true;
+
+		if (fHeader.levelCount > kMaxLevels || fHeader.indexCount == 0)
+			return false;
+
+		const uint64_t size = fFile.Size();
+		const uint64_t levelDataSize = uint64_t(fHeader.levelCount) * sizeof(LevelDescriptor);
+		if (fHeader.levelDataOffset > size || levelDataSize > size - fHeader.levelDataOffset)
+			return false;
+
+		fLevels.resize(fHeader.levelCount);
+		memcpy(fLevels.data(), fFile.Data() + fHeader.levelDataOffset, levelDataSize);
+
+		for (const LevelDescriptor& level : fLevels) {
+			if (level.indexCount == 0 || level.indexCount % 3 != 0
+				|| uint64_t(level.firstIndex) + level.indexCount > fHeader.indexCount || !(level.error >= 0))
+				return false;
+		}
+
+		return true;
+	}
+
+	// One pass over the index blob, so a corrupt file can't make the GPU
+	// read past the vertex buffer
+	bool
+	validateIndices() const
+	{
+		if (fHeader.indexType == GL_UNSIGNED_SHORT)
+			return indicesInRange<uint16_t>();
+
+		return indicesInRange<uint32_t>();
+	}
+
+	template<typename Index>
+	bool
+	indicesInRange() const
+	{
+		const std::byte* indexData = fFile.Data() + fHeader.indexDataOffset;
+
+		// The blob is only guaranteed kBlobAlignment alignment by writers
+		// that follow the format, so read through memcpy
+		Index largest = 0;
+		for (uint32_t index = 0; index < fHeader.indexCount; index++) {
+			Index value;
+			memcpy(&value, indexData + (uint64_t(index) * sizeof(Index)), sizeof(Index));
+			largest = std::max(largest, value);
+		}
+
+		return largest < fHeader.vertexCount;
+	}
+
+private:
+	MappedFile fFile;
+	Header fHeader{};
+	std::vector<AttributeDescriptor> fAttributes;
+	std::vector<LevelDescriptor> fLevels;
+};
+
+} // namespace MeshFile
+
+
+#endif //HW2A_MESHFILE_HPP
@@ -0,0 +1,512 @@
+// Assignment 2a - Programming Interactive 2D Graphics with OpenGL
+// Work by Jacob Secunda
+#ifndef HW2A_MESHLOD_HPP
+#define HW2A_MESHLOD_HPP
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <span>
+#include <vector>
+
+#include "IndexedMesh.hpp"
+#include "MeshFile.hpp"
+#include "MeshOptimizer.hpp"
+
+// Levels of detail for an IndexedMesh: coarser triangle lists over the same
+// vertices, made by collapsing edges, and picked at draw time from how many
+// pixels a model unit covers.
+//
+// Each collapse moves a vertex onto a neighbor (a half-edge collapse), so
+// every level indexes the one vertex buffer and all of them share one index
+// buffer. Collapses are ranked by quadric error in (x, y, r, g, b) space
+// (Garland and Heckbert, "Simplifying Surfaces with Color and Texture using
+// Quadric Error Metrics", 1998): each triangle contributes the squared
+// distance from its plane through position and color, so flat runs of one
+// color or of a linear gradient go first, and color edges are kept. Outline
+// vertices only slide along the outline, and no collapse may flip a
+// triangle.
+namespace MeshLOD {
+
+struct Level {
+	uint32_t firstIndex = 0;
+	uint32_t indexCount = 0;
+	float error = 0;	// in model units; a color change of one full channel counts as kColorWeight
+};
+
+static constexpr size_t kMaxLevels = 8;
+static constexpr double kLevelTriangleRatio = 0.5;	// each level aims for half the triangles of the one before
+static constexpr double kMinLevelReduction = 0.1;	// a level must drop at least this share of them to be kept
+static constexpr size_t kMinLevelTriangles = 8;
+static constexpr double kColorWeight = 0.25;
+static constexpr double kBoundaryWeight = 4;
+
+// Error a level may show on screen before a finer one is drawn instead
+static constexpr float kDefaultPixelError = 1.f;
+
+namespace Detail {
+
+static constexpr size_t kDimensions = 5;
+static constexpr double kPassCostSlack = 1.5;
+static constexpr size_t kMinPassProgress = 16;	// a pass should make 1/16 of the collapses still needed
+using Vector = std::array<double, kDimensions>;
+
+static inline double
+dot(const Vector& a, const Vector& b)
+{
+	double sum = 0;
+	for (size_t component = 0; component < kDimensions; component++)
+		sum += a[component] * b[component];
+
+	return sum;
+}
+
+// Weighted sum of squared distances to affine subspaces, as v'Av + 2b'v + c
+struct Quadric {
+	double a[kDimensions][kDimensions] = {};
+	Vector b = {};
+	double c = 0;
+	double weight = 0;
+
+public:
+	Quadric&
+	operator+=(const Quadric& other)
+	{
+		for (size_t row = 0; row < kDimensions; row++) {
+			for (size_t column = 0; column < kDimensions; column++)
+				a[row][column] += other.a[row][column];
+
+			b[row] += other.b[row];
+		}
+
+		c += other.c;
+		weight += other.weight;
+		return *this;
+	}
+
+	[[nodiscard]] double
+	Evaluate(const Vector& v) const
+	{
+		double sum = c;
+		for (size_t row = 0; row < kDimensions; row++) {
+			double rowSum = 2 * b[row];
+			for (size_t column = 0; column < kDimensions; column++)
+				rowSum += a[row][column] * v[column];
+
+			sum += rowSum * v[row];
+		}
+
+		// Rounding can leave tiny negatives for points on the subspace
+		return std::max(sum, 0.0);
+	}
+
+	// Description: Returns the weighted mean squared distance.
+	[[nodiscard]] double Mean(const Vector& v) const { return (weight > 0) ? Evaluate(v) / weight : 0; }
+
+	// Description: Adds the squared distance from the subspace through
+	// 'origin' spanned by the orthonormal 'axes', times 'weight'.
+	void
+	AddSubspace(const Vector& origin, std::span<const Vector> axes, double weight)
+	{
+		this->weight += weight;
+
+		// A = I - sum(e e'), b = sum((p.e) e) - p, c = p.p - sum((p.e)^2)
+		for (size_t row = 0; row < kDimensions; row++) {
+			a[row][row] += weight;
+			b[row] -= weight * origin[row];
+		}
+
+		c += weight * dot(origin, origin);
+
+		for (const Vector& axis : axes) {
+			const double projection = dot(origin, axis);
+			for (size_t row = 0; row < kDimensions; row++) {
+				for (size_t column = 0; column < kDimensions; column++)
+					a[row][column] -= weight * axis[row] * axis[column];
+
+				b[row] += weight * projection * axis[row];
+			}
+
+			c -= weight * projection * projection;
+		}
+	}
+};
+
+static inline Vector
+vertexPoint(const Model& model, uint32_t vertex)
+{
+	const FloatType2D& position = model.vertices[vertex];
+	const ColorType3D& color = model.colors[vertex];
+	return {position.x, position.y, color.r * kColorWeight, color.g * kColorWeight, color.b * kColorWeight};
+}
+
+// Makes 'vector' orthogonal to 'axis' and unit length; false if nothing is left
+static inline bool
+orthonormalize(Vector& vector, const Vector* axis)
+{
+	if (axis != nullptr) {
+		const double projection = dot(vector, *axis);
+		for (size_t component = 0; component < kDimensions; component++)
+			vector[component] -= projection * (*axis)[component];
+	}
+
+	const double length = std::sqrt(dot(vector, vector));
+	if (length <= 1e-12)
+		return false;
+
+	for (double& component : vector)
+		component /= length;
+
+	return true;
+}
+
+static inline double
+signedArea(const FloatType2D& a, const FloatType2D& b, const FloatType2D& c)
+{
+	return (double(b.x - a.x) * double(c.y - a.y)) - (double(b.y - a.y) * double(c.x - a.x));
+}
+
+static inline uint64_t
+edgeKey(uint32_t a, uint32_t b)
+{
+	return (uint64_t(std::min(a, b)) << 32) | std::max(a, b);
+}
+
+// Triangles weigh by area and outline edges by length; the two are
+// averaged apart, so a collapse costs a squared distance in model units
+struct VertexQuadrics {
+	Quadric fill;
+	Quadric outline;
+
+public:
+	VertexQuadrics&
+	operator+=(const VertexQuadrics& other)
+	{
+		fill += other.fill;
+		outline += other.outline;
+		return *this;
+	}
+
+	[[nodiscard]] double Cost(const Vector& v) const { return fill.Mean(v) + (kBoundaryWeight * outline.Mean(v)); }
+};
+
+struct Edge {
+	uint32_t a;
+	uint32_t b;
+	uint32_t uses;	// triangles sharing it; 1 on the outline
+};
+
+// Description: Replaces 'edges' with the distinct edges of 'indices'.
+static inline void
+countEdges(std::span<const uint32_t> indices, std::vector<uint64_t>& keys, std::vector<Edge>& edges)
+{
+	keys.resize(indices.size());
+	for (size_t index = 0; index < indices.size(); index++)
+		keys[index] = edgeKey(indices[index], indices[index - (index % 3) + (((index % 3) + 1) % 3)]);
+
+	std::sort(keys.begin(), keys.end());
+
+	edges.clear();
+	for (size_t first = 0, last = 0; first < keys.size(); first = last) {
+		while (last < keys.size() && keys[last] == keys[first])
+			last++;
+
+		edges.push_back({uint32_t(keys[first] >> 32), uint32_t(keys[first]), uint32_t(last - first)});
+	}
+}
+
+struct Collapse {
+	uint32_t from;
+	uint32_t to;
+	double cost;
+};
+
+// Accumulated quadrics for every vertex, carried from level to level
+static inline std::vector<VertexQuadrics>
+buildQuadrics(const IndexedMesh& mesh)
+{
+	std::vector<VertexQuadrics> quadrics(mesh.vertices.VertexCount());
+
+	for (size_t triangle = 0; triangle + 2 < mesh.indices.size(); triangle += 3) {
+		const uint32_t* corners = &mesh.indices[triangle];
+		const Vector origin = vertexPoint(mesh.vertices, corners[0]);
+		const Vector p1 = vertexPoint(mesh.vertices, corners[1]);
+		const Vector p2 = vertexPoint(mesh.vertices, corners[2]);
+
+		Vector axes[2];
+		for (size_t component = 0; component < kDimensions; component++) {
+			axes[0][component] = p1[component] - origin[component];
+			axes[1][component] = p2[component] - origin[component];
+		}
+
+		const double area = std::abs(signedArea(mesh.vertices.vertices[corners[0]], mesh.vertices.vertices[corners[1]],
+			mesh.vertices.vertices[corners[2]])) / 2;
+		if (area > 0 && orthonormalize(axes[0], nullptr) && orthonormalize(axes[1], &axes[0])) {
+			Quadric quadric;
+			quadric.AddSubspace(origin, axes, area);
+			for (size_t corner = 0; corner < 3; corner++)
+				quadrics[corners[corner]].fill += quadric;
+		}
+	}
+
+	// Outline edges also hold their ends to the line through them, so the
+	// silhouette survives even where the color is flat
+	std::vector<uint64_t> keys;
+	std::vector<Edge> edges;
+	countEdges(mesh.indices, keys, edges);
+	for (const auto& [a, b, uses] : edges) {
+		if (uses != 1)
+			continue;
+
+		const FloatType2D& pa = mesh.vertices.vertices[a];
+		const FloatType2D& pb = mesh.vertices.vertices[b];
+
+		Vector axes[4] = {{pb.x - pa.x, pb.y - pa.y, 0, 0, 0}, {0, 0, 1, 0, 0}, {0, 0, 0, 1, 0}, {0, 0, 0, 0, 1}};
+		const double length = std::hypot(double(pb.x - pa.x), double(pb.y - pa.y));
+		if (!orthonormalize(axes[0], nullptr))
+			continue;
+
+		Quadric quadric;
+		quadric.AddSubspace(vertexPoint(mesh.vertices, a), axes, length);
+		quadrics[a].outline += quadric;
+		quadrics[b].outline += quadric;
+	}
+
+	return quadrics;
+}
+
+// Description: Collapses edges of 'indices' in passes, cheapest first,
+// until at most 'targetIndexCount' indices remain or nothing more can go.
+// Each pass takes the cheapest collapses that don't touch each other, up to
+// about the cost of the ones it needs. Returns the largest collapse cost,
+// which never shrinks from one call to the next because 'quadrics' accumulate.
+static inline double
+simplify(const Model& model, std::vector<uint32_t>& indices, std::vector<VertexQuadrics>& quadrics, size_t targetIndexCount)
+{
+	const size_t vertexCount = model.VertexCount();
+	double largestCost = 0;
+
+	std::vector<uint32_t> triangleOffsets(vertexCount + 1);
+	std::vector<uint32_t> vertexTriangles;
+	std::vector<bool> onOutline(vertexCount);
+	std::vector<bool> locked(vertexCount);
+	std::vector<uint32_t> remap(vertexCount);
+	std::vector<uint64_t> keys;
+	std::vector<Edge> edges;
+	std::vector<Collapse> collapses;
+
+	while (indices.size() > targetIndexCount) {
+		const size_t triangleCount = indices.size() / 3;
+
+		// Triangles around each vertex
+		std::fill(triangleOffsets.begin(), triangleOffsets.end(), 0);
+		for (uint32_t index : indices)
+			triangleOffsets[index + 1]++;
+
+		for (size_t vertex = 0; vertex < vertexCount; vertex++)
+			triangleOffsets[vertex + 1] += triangleOffsets[vertex];
+
+		vertexTriangles.resize(indices.size());
+		std::vector<uint32_t> fill(triangleOffsets.begin(), triangleOffsets.end() - 1);
+		for (size_t index = 0; index < indices.size(); index++)
+			vertexTriangles[fill[indices[index]]++] = uint32_t(index / 3);
+
+		// Edges used by one triangle are on the outline, and so are their ends
+		countEdges(indices, keys, edges);
+
+		std::fill(onOutline.begin(), onOutline.end(), false);
+		for (const auto& [a, b, uses] : edges) {
+			if (uses == 1) {
+				onOutline[a] = true;
+				onOutline[b] = true;
+			}
+		}
+
+		// Both directions of every edge; outline vertices may only move along the outline
+		collapses.clear();
+		for (const auto& [a, b, uses] : edges) {
+			if (!onOutline[a] || uses == 1)
+				collapses.push_back({a, b, quadrics[a].Cost(vertexPoint(model, b))});
+			if (!onOutline[b] || uses == 1)
+				collapses.push_back({b, a, quadrics[b].Cost(vertexPoint(model, a))});
+		}
+
+		std::sort(collapses.begin(), collapses.end(),
+			[](const Collapse& a, const Collapse& b) { return a.cost < b.cost; });
+
+		// Collapses touching the same triangles wait for the next pass
+		std::fill(locked.begin(), locked.end(), false);
+		for (uint32_t vertex = 0; vertex < vertexCount; vertex++)
+			remap[vertex] = vertex;
+
+		if (collapses.empty())
+			break;
+
+		// An interior collapse removes two triangles. Past the cost of the ones
+		// needed, stop if enough went through; if the cheaper ones were mostly
+		// locked or refused, raise the limit and go on.
+		const size_t removableTriangles = triangleCount - (targetIndexCount / 3);
+		const size_t neededCollapses = std::clamp<size_t>(removableTriangles / 2, 1, collapses.size());
+		double passCostLimit = collapses[neededCollapses - 1].cost * kPassCostSlack;
+		size_t removedTriangles = 0;
+		size_t collapsed = 0;
+
+		for (const Collapse& collapse : collapses) {
+			if (removedTriangles >= removableTriangles)
+				break;
+
+			if (collapse.cost > passCostLimit) {
+				if (collapsed * kMinPassProgress >= neededCollapses)
+					break;
+
+				passCostLimit = collapse.cost * kPassCostSlack;
+			}
+
+			if (locked[collapse.from] || locked[collapse.to])
+				continue;
+
+			// Refuse collapses that would flip (or flatten) a triangle that stays
+			bool flips = false;
+			size_t sharedTriangles = 0;
+			for (uint32_t offset = triangleOffsets[collapse.from]; offset < triangleOffsets[collapse.from + 1] && !flips; offset++) {
+				const uint32_t* corners = &indices[vertexTriangles[offset] * 3];
+				if (corners[0] == collapse.to || corners[1] == collapse.to || corners[2] == collapse.to) {
+					sharedTriangles++;
+					continue;
+				}
+
+				FloatType2D moved[3];
+				for (size_t corner = 0; corner < 3; corner++)
+					moved[corner] = model.vertices[(corners[corner] == collapse.from) ? collapse.to : corners[corner]];
+
+				const double before = signedArea(model.vertices[corners[0]], model.vertices[corners[1]], model.vertices[corners[2]]);
+				const double after = signedArea(moved[0], moved[1], moved[2]);
+				flips = (before > 0) ? (after <= 0) : (after >= 0);
+			}
+
+			if (flips)
+				continue;
+
+			for (uint32_t offset = triangleOffsets[collapse.from]; offset < triangleOffsets[collapse.from + 1]; offset++) {
+				const uint32_t* corners = &indices[vertexTriangles[offset] * 3];
+				locked[corners[0]] = locked[corners[1]] = locked[corners[2]] = true;
+			}
+
+			remap[collapse.from] = collapse.to;
+			quadrics[collapse.to] += quadrics[collapse.from];
+			largestCost = std::max(largestCost, collapse.cost);
+			removedTriangles += sharedTriangles;
+			collapsed++;
+		}
+
+		if (collapsed == 0)
+			break;
+
+		// Triangles that lost an edge are gone
+		size_t kept = 0;
+		for (size_t triangle = 0; triangle < indices.size(); triangle += 3) {
+			const uint32_t a = remap[indices[triangle]];
+			const uint32_t b = remap[indices[triangle + 1]];
+			const uint32_t c = remap[indices[triangle + 2]];
+			if (a == b || b == c || c == a)
+				continue;
+
+			indices[kept++] = a;
+			indices[kept++] = b;
+			indices[kept++] = c;
+		}
+
+		indices.resize(kept);
+	}
+
+	return largestCost;
+}
+
+} // namespace Detail
+
+
+// Description: Appends coarser versions of 'mesh' to its indices and returns
+// every level, the original first. Stops at kMaxLevels, at
+// kMinLevelTriangles, or when a level barely shrinks.
+// 	- Collapsing keeps the surviving triangles in the full level's order, so
+// 	  overlaps draw the same at every level. Only when 'options' asks for
+// 	  TriangleOrder::kVertexCache is each level reordered for the cache.
+// 	- Slow and memory hungry (around 1 KB per vertex while it runs), so
+// 	  large models should have their levels built offline, see MeshFile.
+static inline std::vector<Level>
+BuildLevels(IndexedMesh& mesh, const MeshOptimizer::Options& options = {})
+{
+	std::vector<Level> levels{{0, uint32_t(mesh.indices.size()), 0}};
+
+	std::vector<Detail::VertexQuadrics> quadrics = Detail::buildQuadrics(mesh);
+	std::vector<uint32_t> indices = mesh.indices;
+
+	while (levels.size() < kMaxLevels && indices.size() / 3 > kMinLevelTriangles) {
+		const size_t previousCount = indices.size();
+		const size_t targetCount = std::max<size_t>(3 * size_t(double(previousCount / 3) * kLevelTriangleRatio), kMinLevelTriangles * 3);
+		const double cost = Detail::simplify(mesh.vertices, indices, quadrics, targetCount);
+		if (double(indices.size()) > double(previousCount) * (1 - kMinLevelReduction))
+			break;
+
+		std::vector<uint32_t> ordered = indices;
+		if (options.triangleOrder == MeshOptimizer::TriangleOrder::kVertexCache)
+			MeshOptimizer::OptimizeVertexCache(ordered, mesh.vertices.VertexCount());
+
+		levels.push_back({uint32_t(mesh.indices.size()), uint32_t(ordered.size()),
+			std::max(levels.back().error, float(std::sqrt(cost)))});
+		mesh.indices.insert(mesh.indices.end(), ordered.begin(), ordered.end());
+	}
+
+	return levels;
+}
+
+// Description: Returns the coarsest level whose error stays within
+// 'pixelError' pixels at 'pixelScale' pixels per model unit.
+static inline size_t
+SelectLevel(std::span<const Level> levels, float pixelScale, float pixelError = kDefaultPixelError)
+{
+	size_t selected = 0;
+	for (size_t level = 1; level < levels.size(); level++) {
+		if (levels[level].error * pixelScale <= pixelError)
+			selected = level;
+	}
+
+	return selected;
+}
+
+// Description: Converts levels to the ranges stored in a mesh file, and back.
+static inline std::vector<MeshFile::LevelDescriptor>
+ToDescriptors(std::span<const Level> levels)
+{
+	std::vector<MeshFile::LevelDescriptor> descriptors;
+	descriptors.reserve(levels.size());
+	for (const Level& level : levels)
+		descriptors.push_back({level.firstIndex, level.indexCount, level.error, 0});
+
+	return descriptors;
+}
+
+static inline std::vector<Level>
+FromDescriptors(std::span<const MeshFile::LevelDescriptor> descriptors)
+{
+	std::vector<Level> levels;
+	levels.reserve(descriptors.size());
+	for (const MeshFile::LevelDescriptor& descriptor : descriptors)
+		levels.push_back({descriptor.firstIndex, descriptor.indexCount, descriptor.error});
+
+	return levels;
+}
+
+static inline void
+PrintLevels(const char* name, std::span<const Level> levels)
+{
+	for (size_t level = 0; level < levels.size(); level++)
+		printf("%s level %zu: %u triangles, error %g\n", name, level, levels[level].indexCount / 3, levels[level].error);
+}
+
+} // namespace MeshLOD
+
+
+#endif //HW2A_MESHLOD_HPP
@@ -0,0 +1,363 @@
+// Assignment 2a - Programming Interactive 2D Graphics with OpenGL
+// Work by Jacob Secunda
+#ifndef HW2A_MESHOPTIMIZER_HPP
+#define HW2A_MESHOPTIMIZER_HPP
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+#include "IndexedMesh.hpp"
+
+// Reorders an IndexedMesh for the GPU before it is uploaded:
+//
+// 	1. Triangles, either for the post-transform vertex cache (Forsyth's
+// 	   linear-speed algorithm) or spatially along a Morton (Z-order) curve.
+// 	2. Vertices, into the order the triangles first use them, so vertex
+// 	   fetch walks the buffer front to back.
+//
+// Triangles are drawn without a depth test, so where they overlap the last
+// one wins. Options therefore keep TriangleOrder::kSource unless another
+// order is asked for.
+namespace MeshOptimizer {
+
+enum class TriangleOrder {
+	kSource,
+	kVertexCache,
+	kMorton
+};
+
+struct Options {
+	TriangleOrder triangleOrder = TriangleOrder::kSource;
+	bool reorderVertices = true;
+};
+
+struct Statistics {
+	double acmr = 0;		// transformed vertices per triangle (0.5 is ideal for a large grid, 3 the worst)
+	double atvr = 0;		// transformed vertices per unique vertex (1 is ideal)
+	double overfetch = 0;	// bytes fetched per vertex buffer byte (1 is ideal)
+};
+
+static constexpr uint32_t kAnalysisCacheSize = 16;
+static constexpr size_t kCacheLineSize = 64;
+static constexpr size_t kFetchCacheLines = 512;
+
+namespace Detail {
+
+static constexpr uint32_t kNone = std::numeric_limits<uint32_t>::max();
+
+// Forsyth's scoring, see "Linear-Speed Vertex Cache Optimisation" (2006)
+static constexpr int kCacheSize = 32;
+static constexpr float kCacheDecayPower = 1.5f;
+static constexpr float kLastTriangleScore = 0.75f;
+static constexpr float kValenceBoostScale = 2.0f;
+static constexpr float kValenceBoostPower = 0.5f;
+
+static inline float
+vertexScore(int cachePosition, uint32_t remainingTriangles)
+{
+	// Nothing left to draw with this vertex
+	if (remainingTriangles == 0)
+		return -1.f;
+
+	float score = 0.f;
+	if (cachePosition >= 0) {
+		// The last triangle's vertices score the same, so that the order it
+		// was emitted in doesn't matter
+		if (cachePosition < 3) {
+			score = kLastTriangleScore;
+		} else {
+			const float scaler = 1.f / (kCacheSize - 3);
+			score = std::pow(1.f - ((cachePosition - 3) * scaler), kCacheDecayPower);
+		}
+	}
+
+	// Favor vertices with few triangles left, to finish them off
+	return score + (kValenceBoostScale * std::pow(float(remainingTriangles), -kValenceBoostPower));
+}
+
+// Spreads the low 16 bits of 'value' to the even bits
+static inline uint32_t
+spreadBits(uint32_t value)
+{
+	value &= 0xffff;
+	value = (value | (value << 8)) & 0x00ff00ff;
+	value = (value | (value << 4)) & 0x0f0f0f0f;
+	value = (value | (value << 2)) & 0x33333333;
+	value = (value | (value << 1)) & 0x55555555;
+	return value;
+}
+
+} // namespace Detail
+
+
+// Description: Simulates a FIFO post-transform cache and a direct-mapped
+// cache of vertex buffer lines while drawing 'mesh' with 'vertexSize'-byte
+// interleaved vertices.
+static inline Statistics
+Analyze(const IndexedMesh& mesh, size_t vertexSize)
+{
+	Statistics statistics;
+	const size_t triangleCount = mesh.indices.size() / 3;
+	const size_t vertexCount = mesh.vertices.VertexCount();
+	if (triangleCount == 0 || vertexCount == 0)
+		return statistics;
+
+	std::vector<uint32_t> cacheTimestamps(vertexCount, 0);
+	uint32_t time = kAnalysisCacheSize + 1;
+	size_t transformedCount = 0;
+
+	std::array<size_t, kFetchCacheLines> lines;
+	lines.fill(std::numeric_limits<size_t>::max());
+	size_t fetchedBytes = 0;
+
+	for (uint32_t index : mesh.indices) {
+		// FIFO: a vertex is a hit while fewer than kAnalysisCacheSize misses followed it
+		if (time - cacheTimestamps[index] > kAnalysisCacheSize) {
+			cacheTimestamps[index] = time++;
+			transformedCount++;
+
+			// Only transformed vertices are fetched
+			const size_t firstLine = (index * vertexSize) / kCacheLineSize;
+			const size_t lastLine = ((index + 1) * vertexSize - 1) / kCacheLineSize;
+			for (size_t line = firstLine; line <= lastLine; line++) {
+				size_t& slot = lines[line % kFetchCacheLines];
+				if (slot != line) {
+					slot = line;
+					fetchedBytes += kCacheLineSize;
+				}
+			}
+		}
+	}
+
+	statistics.acmr = double(transformedCount) / triangleCount;
+	statistics.atvr = double(transformedCount) / vertexCount;
+	statistics.overfetch = double(fetchedBytes) / double(vertexCount * vertexSize);
+	return statistics;
+}
+
+static inline void
+PrintStatistics(const char* label, const Statistics& statistics)
+{
+	printf("%s: ACMR %.3f, ATVR %.3f, overfetch %.3f\n", label, statistics.acmr, statistics.atvr, statistics.overfetch);
+}
+
+
+// Description: Reorders the triangles in 'indices' so that consecutive
+// triangles share vertices, greedily emitting the triangle whose vertices
+// score best for a simulated LRU cache of Detail::kCacheSize vertices.
+static inline void
+OptimizeVertexCache(std::vector<uint32_t>& indices, size_t vertexCount)
+{
+	using Detail::kCacheSize;
+	using Detail::kNone;
+
+	const size_t triangleCount = indices.size() / 3;
+	if (triangleCount == 0)
+		return;
+
+	// Triangles using each vertex; the first 'remaining[vertex]' of its range are not emitted yet
+	std::vector<uint32_t> remaining(vertexCount, 0);
+	for (size_t corner = 0; corner < triangleCount * 3; corner++)
+		remaining[indices[corner]]++;
+
+	std::vector<uint32_t> adjacencyOffsets(vertexCount + 1, 0);
+	std::inclusive_scan(remaining.begin(), remaining.end(), adjacencyOffsets.begin() + 1);
+
+	std::vector<uint32_t> adjacency(triangleCount * 3);
+	{
+		std::vector<uint32_t> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+		for (size_t corner = 0; corner < triangleCount * 3; corner++)
+			adjacency[fill[indices[corner]]++] = static_cast<uint32_t>(corner / 3);
+	}
+
+	std::vector<int> cachePositions(vertexCount, -1);
+	std::vector<float> vertexScores(vertexCount);
+	for (size_t vertex = 0; vertex < vertexCount; vertex++)
+		vertexScores[vertex] = Detail::vertexScore(-1, remaining[vertex]);
+
+	std::vector<float> triangleScores(triangleCount);
+	for (size_t triangle = 0; triangle < triangleCount; triangle++) {
+		triangleScores[triangle] = vertexScores[indices[triangle * 3]] + vertexScores[indices[triangle * 3 + 1]]
+			+ vertexScores[indices[triangle * 3 + 2]];
+	}
+
+	std::vector<uint8_t> emitted(triangleCount, 0);
+	std::vector<uint32_t> output;
+	output.reserve(triangleCount * 3);
+
+	// Room for the cache plus the three vertices pushing older ones out
+	std::array<uint32_t, kCacheSize + 3> cache;
+	std::array<uint32_t, kCacheSize + 3> newCache;
+	size_t cacheCount = 0;
+
+	uint32_t best = static_cast<uint32_t>(std::max_element(triangleScores.begin(), triangleScores.end()) - triangleScores.begin());
+	size_t cursor = 0;
+
+	while (output.size() < triangleCount * 3) {
+		// Nothing in the cache leads on, start over at the next triangle in source order
+		if (best == kNone) {
+			while (emitted[cursor])
+				cursor++;
+			best = static_cast<uint32_t>(cursor);
+		}
+
+		const uint32_t* triangle = &indices[best * 3];
+		output.insert(output.end(), triangle, triangle + 3);
+		emitted[best] = 1;
+
+		for (int corner = 0; corner < 3; corner++) {
+			const uint32_t vertex = triangle[corner];
+			uint32_t* begin = &adjacency[adjacencyOffsets[vertex]];
+			uint32_t* end = begin + remaining[vertex];
+			uint32_t* found = std::find(begin, end, best);
+			if (found != end) {
+				std::swap(*found, *(end - 1));
+				remaining[vertex]--;
+			}
+		}
+
+		// The triangle's vertices move to the front, in front of the rest of the cache
+		size_t newCount = 0;
+		for (int corner = 0; corner < 3; corner++) {
+			if (std::find(newCache.begin(), newCache.begin() + newCount, triangle[corner]) == newCache.begin() + newCount)
+				newCache[newCount++] = triangle[corner];
+		}
+
+		for (size_t entry = 0; entry < cacheCount; entry++) {
+			const uint32_t vertex = cache[entry];
+			if (vertex != triangle[0] && vertex != triangle[1] && vertex != triangle[2])
+				newCache[newCount++] = vertex;
+		}
+
+		// Rescore everything that moved, including the vertices that fell out
+		for (size_t entry = 0; entry < newCount; entry++) {
+			const uint32_t vertex = newCache[entry];
+			cachePositions[vertex] = (entry < kCacheSize) ? static_cast<int>(entry) : -1;
+
+			const float score = Detail::vertexScore(cachePositions[vertex], remaining[vertex]);
+			const float delta = score - vertexScores[vertex];
+			vertexScores[vertex] = score;
+
+			for (uint32_t slot = 0; slot < remaining[vertex]; slot++)
+				triangleScores[adjacency[adjacencyOffsets[vertex] + slot]] += delta;
+		}
+
+		// The next triangle is the best one touching the cache
+		best = kNone;
+		float bestScore = -std::numeric_limits<float>::infinity();
+		cacheCount = std::min<size_t>(newCount, kCacheSize);
+		for (size_t entry = 0; entry < cacheCount; entry++) {
+			const uint32_t vertex = newCache[entry];
+			for (uint32_t slot = 0; slot < remaining[vertex]; slot++) {
+				const uint32_t candidate = adjacency[adjacencyOffsets[vertex] + slot];
+				if (triangleScores[candidate] > bestScore) {
+					best = candidate;
+					bestScore = triangleScores[candidate];
+				}
+			}
+		}
+
+		std::swap(cache, newCache);
+	}
+
+	indices = std::move(output);
+}
+
+
+// Description: Sorts the triangles of 'mesh' by the Morton code of their
+// centroids, quantized to 16 bits per axis over the mesh's bounding box.
+static inline void
+SortTrianglesSpatially(IndexedMesh& mesh)
+{
+	const size_t triangleCount = mesh.indices.size() / 3;
+	if (triangleCount == 0)
+		return;
+
+	const std::vector<FloatType2D>& vertices = mesh.vertices.vertices;
+	FloatType2D minimum = vertices[0];
+	FloatType2D maximum = vertices[0];
+	for (const FloatType2D& vertex : vertices) {
+		minimum = {std::min(minimum.x, vertex.x), std::min(minimum.y, vertex.y)};
+		maximum = {std::max(maximum.x, vertex.x), std::max(maximum.y, vertex.y)};
+	}
+
+	// Centroids are three vertices summed, so the scale includes the division by 3
+	const float scaleX = (maximum.x > minimum.x) ? 65535.f / (3 * (maximum.x - minimum.x)) : 0.f;
+	const float scaleY = (maximum.y > minimum.y) ? 65535.f / (3 * (maximum.y - minimum.y)) : 0.f;
+
+	std::vector<uint32_t> codes(triangleCount);
+	for (size_t triangle = 0; triangle < triangleCount; triangle++) {
+		const FloatType2D& a = vertices[mesh.indices[triangle * 3]];
+		const FloatType2D& b = vertices[mesh.indices[triangle * 3 + 1]];
+		const FloatType2D& c = vertices[mesh.indices[triangle * 3 + 2]];
+
+		const uint32_t x = static_cast<uint32_t>((a.x + b.x + c.x - 3 * minimum.x) * scaleX);
+		const uint32_t y = static_cast<uint32_t>((a.y + b.y + c.y - 3 * minimum.y) * scaleY);
+		codes[triangle] = Detail::spreadBits(x) | (Detail::spreadBits(y) << 1);
+	}
+
+	std::vector<uint32_t> order(triangleCount);
+	std::iota(order.begin(), order.end(), 0);
+	std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return codes[a] < codes[b]; });
+
+	std::vector<uint32_t> sorted(mesh.indices.size());
+	for (size_t triangle = 0; triangle < triangleCount; triangle++)
+		std::copy_n(&mesh.indices[order[triangle] * 3], 3, &sorted[triangle * 3]);
+
+	mesh.indices = std::move(sorted);
+}
+
+
+// Description: Renumbers the vertices of 'mesh' in the order the indices
+// first use them, dropping vertices no triangle uses.
+static inline void
+OptimizeVertexFetch(IndexedMesh& mesh)
+{
+	std::vector<uint32_t> remap(mesh.vertices.VertexCount(), Detail::kNone);
+	Model reordered;
+	reordered.vertices.reserve(mesh.vertices.VertexCount());
+	reordered.colors.reserve(mesh.vertices.VertexCount());
+
+	for (uint32_t& index : mesh.indices) {
+		if (remap[index] == Detail::kNone) {
+			remap[index] = static_cast<uint32_t>(reordered.VertexCount());
+			reordered.vertices.push_back(mesh.vertices.vertices[index]);
+			reordered.colors.push_back(mesh.vertices.colors[index]);
+		}
+
+		index = remap[index];
+	}
+
+	mesh.vertices = std::move(reordered);
+}
+
+
+// Description: Runs the stages 'options' asks for, in order.
+static inline void
+Optimize(IndexedMesh& mesh, const Options& options = {})
+{
+	switch (options.triangleOrder) {
+		case TriangleOrder::kSource:
+			break;
+		case TriangleOrder::kVertexCache:
+			OptimizeVertexCache(mesh.indices, mesh.vertices.VertexCount());
+			break;
+		case TriangleOrder::kMorton:
+			SortTrianglesSpatially(mesh);
+			break;
+	}
+
+	if (options.reorderVertices)
+		OptimizeVertexFetch(mesh);
+}
+
+} // namespace MeshOptimizer
+
+
+#endif //HW2A_MESHOPTIMIZER_HPP
@@ -0,0 +1,340 @@
+// Assignment 2a - Programming Interactive 2D Graphics with OpenGL
+// Work by Jacob Secunda
+#ifndef HW2A_MODEL_HPP
+#define HW2A_MODEL_HPP
+
+#include "glad/glad.h"
+
+#include <algorithm>
+#include <barrier>
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#include <new>
+#include <thread>
+#include <vector>
+
+#include "MappedFile.hpp"
+
+// initialize some basic structure types
+struct FloatType2D {
+	GLfloat x;
+	GLfloat y;
+};
+
+struct ColorType3D {
+	GLfloat r;
+	GLfloat g;
+	GLfloat b;
+};
+
+// A triangle list: every three consecutive vertices form one triangle
+struct Model {
+	std::vector<FloatType2D> vertices;
+	std::vector<ColorType3D> colors;
+
+	[[nodiscard]] size_t VertexCount() const { return vertices.size(); }
+
+	void
+	Clear()
+	{
+		vertices.clear();
+		colors.clear();
+	}
+};
+
+
+namespace ModelDetail {
+
+static constexpr size_t kReadChunkSize = 1 << 20;
+
+// Smallest piece of a file worth handing to its own thread
+static constexpr size_t kMinParallelChunkSize = 1 << 20;
+
+static inline const char*
+skipBlanks(const char* position, const char* end)
+{
+	while (position != end && (*position == ' ' || *position == '\t' || *position == '\r'))
+		position++;
+
+	return position;
+}
+
+// Returns 1 for a vertex, 0 for a blank/comment line and -1 for a malformed line
+static inline int
+parseLine(const char* position, const char* end, FloatType2D& vertex, ColorType3D& color)
+{
+	position = skipBlanks(position, end);
+	if (position == end || *position == '#')
+		return 0;
+
+	GLfloat* fields[] = {&vertex.x, &vertex.y, &color.r, &color.g, &color.b};
+	for (GLfloat* field : fields) {
+		position = skipBlanks(position, end);
+
+		const std::from_chars_result result = std::from_chars(position, end, *field);
+		if (result.ec != std::errc())
+			return -1;
+
+		position = result.ptr;
+	}
+
+	// Anything after the fifth value has to be a comment
+	position = skipBlanks(position, end);
+	return (position == end || *position == '#') ? 1 : -1;
+}
+
+
+// Drops the vertices after the last whole triangle
+static inline void
+dropPartialTriangle(const char* path, Model& model)
+{
+	const size_t remainder = model.VertexCount() % 3;
+	if (remainder != 0) {
+		printf("model file %s ends with a partial triangle; ignoring its last %zu vertices\n", path, remainder);
+		model.vertices.resize(model.VertexCount() - remainder);
+		model.colors.resize(model.VertexCount());
+	}
+}
+
+// What one thread of LoadTextModelParallel() parsed
+struct ParsedChunk {
+	std::vector<FloatType2D> vertices;
+	std::vector<ColorType3D> colors;
+	size_t lineCount = 0;
+	size_t errorLine = 0;	// line within the chunk, 0 if there was no error
+	bool outOfMemory = false;
+};
+
+static inline void
+parseChunk(const char* begin, const char* end, ParsedChunk& chunk)
+{
+	chunk.vertices.reserve(static_cast<size_t>(end - begin) / 20);
+	chunk.colors.reserve(static_cast<size_t>(end - begin) / 20);
+
+	while (begin != end) {
+		const char* lineEnd = static_cast<const char*>(memchr(begin, '\n', end - begin));
+		if (lineEnd == nullptr)
+			lineEnd = end;
+
+		chunk.lineCount++;
+
+		FloatType2D vertex;
+		ColorType3D color;
+		const int parsed = parseLine(begin, lineEnd, vertex, color);
+		if (parsed < 0) {
+			chunk.errorLine = chunk.lineCount;
+			return;
+		}
+
+		if (parsed > 0) {
+			chunk.vertices.push_back(vertex);
+			chunk.colors.push_back(color);
+		}
+
+		begin = (lineEnd == end) ? end : lineEnd + 1;
+	}
+}
+
+} // namespace ModelDetail
+
+
+// Description: Reads a text model, one vertex per line as "x y r g b"
+// (position, then color in [0, 1]). Blank lines and '#' comments are skipped.
+// 	- The file is streamed through one fixed-size buffer and parsed in place
+// 	  with std::from_chars, so nothing is allocated per line.
+// 	- A trailing partial triangle is dropped with a warning.
+static inline bool
+LoadTextModel(const char* path, Model& model)
+{
+	model.Clear();
+
+	FILE* file = fopen(path, "rb");
+	if (file == nullptr) {
+		printf("can't open model file %s\n", path);
+		return false;
+	}
+
+	// A vertex line takes at least ~20 bytes, so this rarely has to grow
+	fseek(file, 0, SEEK_END);
+	const long fileSize = ftell(file);
+	fseek(file, 0, SEEK_SET);
+	if (fileSize > 0) {
+		model.vertices.reserve(static_cast<size_t>(fileSize) / 20);
+		model.colors.reserve(static_cast<size_t>(fileSize) / 20);
+	}
+
+	std::vector<char> buffer(ModelDetail::kReadChunkSize);
+	size_t carried = 0;
+	size_t lineNumber = 0;
+	bool succeeded = true;
+
+	const auto parseLine = [&](const char* begin, const char* end) {
+		lineNumber++;
+
+		FloatType2D vertex;
+		ColorType3D color;
+		const int parsed = ModelDetail::parseLine(begin, end, vertex, color);
+		if (parsed < 0) {
+			printf("malformed vertex on line %zu of model file %s\n", lineNumber, path);
+			return false;
+		}
+
+		if (parsed > 0) {
+			model.vertices.push_back(vertex);
+			model.colors.push_back(color);
+		}
+
+		return true;
+	};
+
+	while (succeeded) {
+		const size_t count = fread(buffer.data() + carried, 1, buffer.size() - carried, file);
+		const char* begin = buffer.data();
+		const char* end = begin + carried + count;
+
+		const char* lineEnd;
+		while (succeeded && (lineEnd = static_cast<const char*>(memchr(begin, '\n', end - begin))) != nullptr) {
+			succeeded = parseLine(begin, lineEnd);
+			begin = lineEnd + 1;
+		}
+
+		if (count == 0) {
+			// Last line without a newline
+			if (succeeded && begin != end)
+				succeeded = parseLine(begin, end);
+			break;
+		}
+
+		// Keep the partial line for the next read
+		carried = end - begin;
+		if (carried == buffer.size()) {
+			printf("line %zu of model file %s is too long\n", lineNumber + 1, path);
+			succeeded = false;
+			break;
+		}
+
+		memmove(buffer.data(), begin, carried);
+	}
+
+	fclose(file);
+
+	if (!succeeded) {
+		model.Clear();
+		return false;
+	}
+
+	ModelDetail::dropPartialTriangle(path, model);
+	return true;
+}
+
+
+// Description: Reads the same text format as LoadTextModel() on several threads.
+// 	- The file is mapped and cut into one newline-aligned chunk per thread.
+// 	  Each thread parses its chunk into its own arrays; once all are done, a
+// 	  prefix sum over the chunk sizes gives every thread its place in
+// 	  'model', and the threads copy their vertices there in parallel.
+// 	- 'threadCount' 0 uses every hardware thread. Small files use fewer
+// 	  threads than asked for, down to 1 MiB per thread.
+// 	- Running out of memory fails the load instead of throwing.
+static inline bool
+LoadTextModelParallel(const char* path, Model& model, unsigned threadCount = 0)
+{
+	model.Clear();
+
+	MappedFile file;
+	if (!file.Open(path))
+		return false;
+
+	const char* data = reinterpret_cast<const char*>(file.Data());
+	const size_t size = file.Size();
+
+	if (threadCount == 0)
+		threadCount = std::max(1u, std::thread::hardware_concurrency());
+	threadCount = static_cast<unsigned>(std::clamp<size_t>(size / ModelDetail::kMinParallelChunkSize, 1, threadCount));
+
+	// Each boundary is moved forward to the start of the next line
+	std::vector<const char*> bounds(threadCount + 1);
+	bounds[0] = data;
+	bounds[threadCount] = data + size;
+	for (unsigned chunk = 1; chunk < threadCount; chunk++) {
+		const char* guess = std::max(data + (size / threadCount) * chunk, bounds[chunk - 1]);
+		const char* newline = static_cast<const char*>(memchr(guess, '\n', (data + size) - guess));
+		bounds[chunk] = (newline != nullptr) ? newline + 1 : data + size;
+	}
+
+	std::vector<ModelDetail::ParsedChunk> chunks(threadCount);
+	std::vector<size_t> offsets(threadCount + 1, 0);
+	bool succeeded = true;
+
+	// Runs once every chunk is parsed, before any thread copies its results.
+	// A barrier completion must not throw, so allocation failures end up in 'succeeded'.
+	const auto stitch = [&]() noexcept {
+		size_t linesBefore = 0;
+		for (unsigned chunk = 0; chunk < threadCount; chunk++) {
+			if (chunks[chunk].outOfMemory) {
+				printf("out of memory parsing model file %s\n", path);
+				succeeded = false;
+				return;
+			}
+
+			if (chunks[chunk].errorLine != 0) {
+				printf("malformed vertex on line %zu of model file %s\n", linesBefore + chunks[chunk].errorLine, path);
+				succeeded = false;
+				return;
+			}
+
+			linesBefore += chunks[chunk].lineCount;
+			offsets[chunk + 1] = offsets[chunk] + chunks[chunk].vertices.size();
+		}
+
+		try {
+			model.vertices.resize(offsets[threadCount]);
+			model.colors.resize(offsets[threadCount]);
+		} catch (const std::bad_alloc&) {
+			printf("out of memory for %zu vertices of model file %s\n", offsets[threadCount], path);
+			succeeded = false;
+		}
+	};
+
+	std::barrier parsed(threadCount, stitch);
+
+	const auto work = [&](unsigned chunk) {
+		ModelDetail::ParsedChunk& result = chunks[chunk];
+		try {
+			ModelDetail::parseChunk(bounds[chunk], bounds[chunk + 1], result);
+		} catch (const std::bad_alloc&) {
+			result = {};
+			result.outOfMemory = true;
+		}
+		parsed.arrive_and_wait();
+
+		if (succeeded) {
+			std::copy(result.vertices.begin(), result.vertices.end(), model.vertices.begin() + offsets[chunk]);
+			std::copy(result.colors.begin(), result.colors.end(), model.colors.begin() + offsets[chunk]);
+		}
+
+		result = {};
+	};
+
+	std::vector<std::thread> threads;
+	threads.reserve(threadCount - 1);
+	for (unsigned chunk = 1; chunk < threadCount; chunk++)
+		threads.emplace_back(work, chunk);
+
+	work(0);
+
+	for (std::thread& thread : threads)
+		thread.join();
+
+	if (!succeeded) {
+		model.Clear();
+		return false;
+	}
+
+	ModelDetail::dropPartialTriangle(path, model);
+	return true;
+}
+
+
+#endif //HW2A_MODEL_HPP
@@ -0,0 +1,141 @@
+// Assignment 2a - Programming Interactive 2D Graphics with OpenGL
+// Work by Jacob Secunda
+#ifndef HW2A_SCENEGRAPH_HPP
+#define HW2A_SCENEGRAPH_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "Matrix.hpp"
+#include "MatrixKernels.hpp"
+
+// A transform hierarchy stored as flat arrays in topological order.
+//
+// A node can only be added under an existing node, so every parent sits
+// before its children. Update() then walks the nodes once, front to back,
+// and only recomputes world matrices whose local matrix or any ancestor
+// changed. World matrices are packed 16 values per node, in node order,
+// ready for glBufferData or glUniformMatrix4fv(..., count, ...).
+//
+// A world matrix is local * parent world, i.e. the node's own transform is
+// applied first, then its parent's (same order as Matrix::MultiplyBy).
+template<typename T>
+class SceneGraph {
+public:
+	using NodeID = uint32_t;
+
+	static constexpr NodeID kNoParent = std::numeric_limits<NodeID>::max();
+	static constexpr size_t kMatrixSize = Matrix4D<T>::Size;
+
+public:
+	void
+	Reserve(size_t nodeCount)
+	{
+		fParents.reserve(nodeCount);
+		fLocals.reserve(nodeCount);
+		fWorlds.reserve(nodeCount * kMatrixSize);
+		fDirty.reserve(nodeCount);
+	}
+
+	// Description: Adds a node with an identity local transform under 'parent'.
+	// 	- Returns kNoParent if 'parent' does not exist yet.
+	NodeID
+	AddNode(NodeID parent = kNoParent)
+	{
+		if (parent != kNoParent && parent >= NodeCount())
+			return kNoParent;
+
+		const NodeID node = static_cast<NodeID>(NodeCount());
+		fParents.push_back(parent);
+		fLocals.emplace_back();
+		fWorlds.resize(fWorlds.size() + kMatrixSize);
+		fDirty.push_back(true);
+		fAnyDirty = true;
+
+		return node;
+	}
+
+	void
+	Clear()
+	{
+		fParents.clear();
+		fLocals.clear();
+		fWorlds.clear();
+		fDirty.clear();
+		fAnyDirty = false;
+	}
+
+	[[nodiscard]] size_t NodeCount() const { return fParents.size(); }
+
+	[[nodiscard]] NodeID Parent(NodeID node) const { return fParents[node]; }
+
+	[[nodiscard]] const Matrix4D<T>& Local(NodeID node) const { return fLocals[node]; }
+
+	// Description: Gives write access to a node's local transform and marks it
+	// (and so its subtree) for recomputation on the next Update().
+	Matrix4D<T>&
+	EditLocal(NodeID node)
+	{
+		fDirty[node] = true;
+		fAnyDirty = true;
+		return fLocals[node];
+	}
+
+	// Description: Recomputes the world matrix of every changed node and of
+	// everything below it, in one linear pass.
+	// 	- Returns the number of world matrices that were recomputed.
+	size_t
+	Update()
+	{
+		if (!fAnyDirty)
+			return 0;
+
+		size_t updatedCount = 0;
+		for (size_t node = 0; node < NodeCount(); node++) {
+			const NodeID parent = fParents[node];
+
+			// Parents precede children, so fDirty[parent] is already final
+			if (parent != kNoParent && fDirty[parent])
+				fDirty[node] = true;
+
+			if (!fDirty[node])
+				continue;
+
+			const T* local = fLocals[node];
+			T* world = fWorlds.data() + (node * kMatrixSize);
+			if (parent == kNoParent)
+				std::copy_n(local, kMatrixSize, world);
+			else
+				MatrixKernels::Multiply<T, 4>(local, fWorlds.data() + (parent * kMatrixSize), world);
+
+			updatedCount++;
+		}
+
+		std::fill(fDirty.begin(), fDirty.end(), false);
+		fAnyDirty = false;
+
+		return updatedCount;
+	}
+
+	// World matrices as of the last Update()
+	[[nodiscard]] const T* WorldMatrices() const { return fWorlds.data(); }
+
+	[[nodiscard]] const T* WorldMatrix(NodeID node) const { return fWorlds.data() + (node * kMatrixSize); }
+
+private:
+	std::vector<NodeID> fParents;
+	std::vector<Matrix4D<T>> fLocals;
+	std::vector<T> fWorlds;
+
+	// One byte per node rather than std::vector<bool>'s bit packing
+	std::vector<uint8_t> fDirty;
+	bool fAnyDirty = false;
+};
+
+/** Types */
+using GLsceneGraph = SceneGraph<GLfloat>;
+
+
+#endif //HW2A_SCENEGRAPH_HPP
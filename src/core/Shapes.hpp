@@ -0,0 +1,176 @@
+// Assignment 2a - Programming Interactive 2D Graphics with OpenGL
+// Work by Jacob Secunda
+#ifndef HW2A_SHAPES_HPP
+#define HW2A_SHAPES_HPP
+
+#include "glad/glad.h"
+
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#include <numbers>
+#include <vector>
+
+#include "CurveTessellator.hpp"
+#include "Model.hpp"
+
+// How a polygon's interior is rasterized
+enum class FillMode {
+	kTriangles,	// triangulated on the CPU, drawn with glDrawElements()
+	kStencil	// outline fans counted in the stencil buffer, then one cover quad
+};
+
+// A filled polygon as read from a shapes file
+struct ShapeDescription {
+	CurvedPolygon2D<GLfloat> shape;
+	ColorType3D color;
+	FillMode fillMode;
+};
+
+
+namespace ShapesDetail {
+
+// Parses up to 'count' floats; returns the number parsed
+static inline size_t
+parseFloats(const char*& position, const char* end, GLfloat* values, size_t count)
+{
+	size_t parsed = 0;
+	for (; parsed < count; parsed++) {
+		while (position != end && (*position == ' ' || *position == '\t'))
+			position++;
+
+		const std::from_chars_result result = std::from_chars(position, end, values[parsed]);
+		if (result.ec != std::errc())
+			break;
+
+		position = result.ptr;
+	}
+
+	return parsed;
+}
+
+static inline bool
+isBlank(const char* position, const char* end)
+{
+	while (position != end && (*position == ' ' || *position == '\t' || *position == '\r'))
+		position++;
+
+	return position == end || *position == '#';
+}
+
+} // namespace ShapesDetail
+
+
+// Description: Reads polygons from a text file:
+// 	shape r g b [triangles | stencil]	starts a polygon and its outline
+// 	hole					starts a hole in the current polygon
+// 	x y					adds a point to the current outline or hole
+// 	quad cx cy x y				adds a quadratic Bezier curve to x y
+// 	cubic ax ay bx by x y			adds a cubic Bezier curve to x y
+// 	arc cx cy radius start end		adds an arc, angles in degrees
+// Blank lines and '#' comments are skipped; the fill mode defaults to triangles.
+// A ring can't start with a Bezier curve.
+static inline bool
+LoadTextShapes(const char* path, std::vector<ShapeDescription>& shapes)
+{
+	shapes.clear();
+
+	FILE* file = fopen(path, "rb");
+	if (file == nullptr) {
+		printf("can't open shapes file %s\n", path);
+		return false;
+	}
+
+	char line[256];
+	size_t lineNumber = 0;
+	bool succeeded = true;
+	Path2D<GLfloat>* ring = nullptr;
+
+	while (succeeded && fgets(line, sizeof(line), file) != nullptr) {
+		lineNumber++;
+
+		const char* position = line;
+		const char* end = line + strcspn(line, "\r\n");
+		if (ShapesDetail::isBlank(position, end))
+			continue;
+
+		if (strncmp(position, "shape", 5) == 0) {
+			position += 5;
+
+			ShapeDescription& shape = shapes.emplace_back();
+			GLfloat color[3];
+			succeeded = ShapesDetail::parseFloats(position, end, color, 3) == 3;
+			shape.color = {color[0], color[1], color[2]};
+
+			while (position != end && (*position == ' ' || *position == '\t'))
+				position++;
+
+			const size_t modeLength = end - position;
+			if (modeLength == 7 && strncmp(position, "stencil", 7) == 0)
+				shape.fillMode = FillMode::kStencil;
+			else if (modeLength == 0 || (modeLength == 9 && strncmp(position, "triangles", 9) == 0))
+				shape.fillMode = FillMode::kTriangles;
+			else
+				succeeded = false;
+
+			ring = &shape.shape.outline;
+		} else if (strncmp(position, "hole", 4) == 0 && ShapesDetail::isBlank(position + 4, end)) {
+			if (shapes.empty())
+				succeeded = false;
+			else
+				ring = &shapes.back().shape.holes.emplace_back();
+		} else if (ring == nullptr) {
+			succeeded = false;
+		} else {
+			// A segment keyword, followed by its numbers
+			size_t count = 2;
+			const char* keyword = position;
+			if (strncmp(keyword, "quad", 4) == 0) {
+				count = 4;
+				position += 4;
+			} else if (strncmp(keyword, "cubic", 5) == 0) {
+				count = 6;
+				position += 5;
+			} else if (strncmp(keyword, "arc", 3) == 0) {
+				count = 5;
+				position += 3;
+			}
+
+			GLfloat values[6];
+			succeeded = ShapesDetail::parseFloats(position, end, values, count) == count
+				&& ShapesDetail::isBlank(position, end);
+			if (!succeeded)
+				break;
+
+			constexpr GLfloat kRadiansPerDegree = std::numbers::pi_v<GLfloat> / 180;
+			switch (count) {
+				case 2:
+					ring->LineTo({values[0], values[1]});
+					break;
+				case 4:
+					succeeded = !ring->Empty();
+					ring->QuadraticTo({values[0], values[1]}, {values[2], values[3]});
+					break;
+				case 6:
+					succeeded = !ring->Empty();
+					ring->CubicTo({values[0], values[1]}, {values[2], values[3]}, {values[4], values[5]});
+					break;
+				case 5:
+					ring->ArcTo({values[0], values[1]}, values[2], values[3] * kRadiansPerDegree, values[4] * kRadiansPerDegree);
+					break;
+			}
+		}
+	}
+
+	fclose(file);
+
+	if (!succeeded) {
+		printf("malformed line %zu in shapes file %s\n", lineNumber, path);
+		shapes.clear();
+	}
+
+	return succeeded;
+}
+
+
+#endif //HW2A_SHAPES_HPP
@@ -0,0 +1,171 @@
+// Assignment 2a - Programming Interactive 2D Graphics with OpenGL
+// Work by Jacob Secunda
+#ifndef HW2A_TRANSFORMPOINTS_HPP
+#define HW2A_TRANSFORMPOINTS_HPP
+
+#include <algorithm>
+#include <span>
+#include <type_traits>
+
+#include "Matrix.hpp"
+#include "MatrixKernels.hpp"
+#include "Point.hpp"
+#include "Vector3D.hpp"
+
+// Bulk application of a Matrix to geometry on the CPU.
+//
+// Points are transformed the same way the vertex shader does it, treating
+// the matrix array as column-major (as uploaded by glUniformMatrix4fv) and the
+// point as (x, y, 0, 1):
+//	x' = M[0] * x + M[4] * y + M[12]
+//	y' = M[1] * x + M[5] * y + M[13]
+// The projective row is ignored, as every matrix this class composes is affine.
+//
+// Each function transforms min(input size, output size) elements and returns
+// that count. The output may be the same memory as the input.
+// T is deduced from the matrix alone, so containers convert to the spans.
+
+
+/** Array of Structs */
+
+template<typename T>
+size_t
+TransformPoints(const Matrix4D<T>& matrix, std::span<const Point2D<std::type_identity_t<T>>> points,
+	std::span<Point2D<std::type_identity_t<T>>> out)
+{
+	const T* m = matrix;
+	const size_t count = std::min(points.size(), out.size());
+	size_t index = 0;
+
+#if HW2A_HAVE_AVX
+	if constexpr (std::is_same_v<T, float>) {
+		// Four interleaved (x, y) pairs per register
+		const __m256 xTerms = _mm256_setr_ps(m[0], m[1], m[0], m[1], m[0], m[1], m[0], m[1]);
+		const __m256 yTerms = _mm256_setr_ps(m[4], m[5], m[4], m[5], m[4], m[5], m[4], m[5]);
+		const __m256 offsets = _mm256_setr_ps(m[12], m[13], m[12], m[13], m[12], m[13], m[12], m[13]);
+
+		for (; index + 4 <= count; index += 4) {
+			const __m256 xy = _mm256_loadu_ps(&points[index].x);
+			const __m256 xx = _mm256_moveldup_ps(xy);
+			const __m256 yy = _mm256_movehdup_ps(xy);
+
+			__m256 result = _mm256_mul_ps(xx, xTerms);
+			result = _mm256_add_ps(result, _mm256_mul_ps(yy, yTerms));
+			result = _mm256_add_ps(result, offsets);
+
+			_mm256_storeu_ps(&out[index].x, result);
+		}
+	}
+#elif HW2A_HAVE_SSE2
+	if constexpr (std::is_same_v<T, float>) {
+		// Two interleaved (x, y) pairs per register
+		const __m128 xTerms = _mm_setr_ps(m[0], m[1], m[0], m[1]);
+		const __m128 yTerms = _mm_setr_ps(m[4], m[5], m[4], m[5]);
+		const __m128 offsets = _mm_setr_ps(m[12], m[13], m[12], m[13]);
+
+		for (; index + 2 <= count; index += 2) {
+			const __m128 xy = _mm_loadu_ps(&points[index].x);
+			const __m128 xx = _mm_shuffle_ps(xy, xy, _MM_SHUFFLE(2, 2, 0, 0));
+			const __m128 yy = _mm_shuffle_ps(xy, xy, _MM_SHUFFLE(3, 3, 1, 1));
+
+			__m128 result = _mm_mul_ps(xx, xTerms);
+			result = _mm_add_ps(result, _mm_mul_ps(yy, yTerms));
+			result = _mm_add_ps(result, offsets);
+
+			_mm_storeu_ps(&out[index].x, result);
+		}
+	}
+#endif
+
+	for (; index < count; index++) {
+		const Point2D<T> point = points[index];
+		out[index].x = (m[0] * point.x) + (m[4] * point.y) + m[12];
+		out[index].y = (m[1] * point.x) + (m[5] * point.y) + m[13];
+	}
+
+	return count;
+}
+
+
+// Each vector is applied as the point (dx, dy, dz, 1), so the translation
+// row is added too. The projective column is ignored, as above.
+template<typename T>
+size_t
+TransformVectors(const Matrix4D<T>& matrix, std::span<const Vector3D<std::type_identity_t<T>>> vectors,
+	std::span<Vector3D<std::type_identity_t<T>>> out)
+{
+	const T* m = matrix;
+	const size_t count = std::min(vectors.size(), out.size());
+
+	for (size_t index = 0; index < count; index++) {
+		const Vector3D<T> vector = vectors[index];
+		out[index].dx = (m[0] * vector.dx) + (m[4] * vector.dy) + (m[8] * vector.dz) + m[12];
+		out[index].dy = (m[1] * vector.dx) + (m[5] * vector.dy) + (m[9] * vector.dz) + m[13];
+		out[index].dz = (m[2] * vector.dx) + (m[6] * vector.dy) + (m[10] * vector.dz) + m[14];
+	}
+
+	return count;
+}
+
+
+/** Structure of Arrays */
+
+// Processes 8 (AVX) or 4 (SSE2) points per instruction for float coordinates.
+template<typename T>
+size_t
+TransformPoints(const Matrix4D<T>& matrix, std::span<const std::type_identity_t<T>> xs,
+	std::span<const std::type_identity_t<T>> ys,
+	std::span<std::type_identity_t<T>> outXs, std::span<std::type_identity_t<T>> outYs)
+{
+	const T* m = matrix;
+	const size_t count = std::min({xs.size(), ys.size(), outXs.size(), outYs.size()});
+	size_t index = 0;
+
+#if HW2A_HAVE_AVX
+	if constexpr (std::is_same_v<T, float>) {
+		const __m256 m0 = _mm256_set1_ps(m[0]), m1 = _mm256_set1_ps(m[1]);
+		const __m256 m4 = _mm256_set1_ps(m[4]), m5 = _mm256_set1_ps(m[5]);
+		const __m256 m12 = _mm256_set1_ps(m[12]), m13 = _mm256_set1_ps(m[13]);
+
+		for (; index + 8 <= count; index += 8) {
+			const __m256 x = _mm256_loadu_ps(xs.data() + index);
+			const __m256 y = _mm256_loadu_ps(ys.data() + index);
+
+			const __m256 newX = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m0, x), _mm256_mul_ps(m4, y)), m12);
+			const __m256 newY = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m1, x), _mm256_mul_ps(m5, y)), m13);
+
+			_mm256_storeu_ps(outXs.data() + index, newX);
+			_mm256_storeu_ps(outYs.data() + index, newY);
+		}
+	}
+#elif HW2A_HAVE_SSE2
+	if constexpr (std::is_same_v<T, float>) {
+		const __m128 m0 = _mm_set1_ps(m[0]), m1 = _mm_set1_ps(m[1]);
+		const __m128 m4 = _mm_set1_ps(m[4]), m5 = _mm_set1_ps(m[5]);
+		const __m128 m12 = _mm_set1_ps(m[12]), m13 = _mm_set1_ps(m[13]);
+
+		for (; index + 4 <= count; index += 4) {
+			const __m128 x = _mm_loadu_ps(xs.data() + index);
+			const __m128 y = _mm_loadu_ps(ys.data() + index);
+
+			const __m128 newX = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m0, x), _mm_mul_ps(m4, y)), m12);
+			const __m128 newY = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m1, x), _mm_mul_ps(m5, y)), m13);
+
+			_mm_storeu_ps(outXs.data() + index, newX);
+			_mm_storeu_ps(outYs.data() + index, newY);
+		}
+	}
+#endif
+
+	for (; index < count; index++) {
+		const T x = xs[index];
+		const T y = ys[index];
+		outXs[index] = (m[0] * x) + (m[4] * y) + m[12];
+		outYs[index] = (m[1] * x) + (m[5] * y) + m[13];
+	}
+
+	return count;
+}
+
+
+#endif //HW2A_TRANSFORMPOINTS_HPP
@@ -0,0 +1,599 @@
+// Assignment 2a - Programming Interactive 2D Graphics with OpenGL
+// Work by Jacob Secunda
+#ifndef HW2A_TRIANGULATOR_HPP
+#define HW2A_TRIANGULATOR_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+#include <set>
+#include <span>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "Point.hpp"
+
+// A simple polygon with optional holes. Either winding is accepted for any
+// ring. Holes must lie inside the outline and must not touch it or each
+// other.
+template<typename T>
+struct Polygon2D {
+	std::vector<Point2D<T>> outline;
+	std::vector<std::vector<Point2D<T>>> holes;
+
+public:
+	[[nodiscard]] size_t
+	PointCount() const
+	{
+		size_t count = outline.size();
+		for (const std::vector<Point2D<T>>& hole : holes)
+			count += hole.size();
+
+		return count;
+	}
+};
+
+
+// Triangulates polygons in O(n log n) by monotone decomposition, as in
+// de Berg et al., "Computational Geometry", chapter 3:
+//
+// 	1. A sweep from top to bottom adds diagonals at split and merge
+// 	   vertices, cutting the polygon into y-monotone pieces.
+// 	2. The pieces are walked out of the planar graph of edges and diagonals.
+// 	3. Each piece is triangulated in linear time with a stack.
+//
+// Output indices refer to the polygon's points in order: the outline, then
+// each hole. Triangles are counter-clockwise.
+//
+// A triangulator reuses its buffers between polygons; use one per thread.
+template<typename T>
+class PolygonTriangulator {
+public:
+	// Description: Appends the triangles of 'polygon' to 'indices'.
+	// 	- 'polygon' must be simple (see Polygon2D). Self-intersecting rings are
+	// 	  not detected: some are refused, others produce overlapping triangles.
+	// 	- Returns false, appending nothing, for a polygon it can't triangulate
+	// 	  (an outline with fewer than 3 points, or a sweep that breaks down).
+	bool
+	Triangulate(const Polygon2D<T>& polygon, std::vector<uint32_t>& indices)
+	{
+		if (!setUp(polygon))
+			return false;
+
+		const size_t firstIndex = indices.size();
+		if (!addDiagonals() || !triangulatePieces(indices)) {
+			indices.resize(firstIndex);
+			return false;
+		}
+
+		return true;
+	}
+
+private:
+	struct Vertex {
+		double x;
+		double y;
+	};
+
+	enum class VertexType : uint8_t {
+		kStart,
+		kEnd,
+		kSplit,
+		kMerge,
+		kRegular
+	};
+
+	static constexpr uint32_t kNone = UINT32_MAX;
+
+	// Sweep order: top to bottom, then left to right on the same line
+	[[nodiscard]] bool
+	above(uint32_t a, uint32_t b) const
+	{
+		const Vertex& pointA = fVertices[a];
+		const Vertex& pointB = fVertices[b];
+		return (pointA.y > pointB.y) || (pointA.y == pointB.y && (pointA.x < pointB.x || (pointA.x == pointB.x && a < b)));
+	}
+
+	[[nodiscard]] static double
+	cross(const Vertex& a, const Vertex& b, const Vertex& c)
+	{
+		return ((b.x - a.x) * (c.y - a.y)) - ((b.y - a.y) * (c.x - a.x));
+	}
+
+	// Copies the rings and links them so the interior is always on the left
+	bool
+	setUp(const Polygon2D<T>& polygon)
+	{
+		if (polygon.outline.size() < 3)
+			return false;
+
+		fVertices.clear();
+		fNext.clear();
+		fPrevious.clear();
+		fDiagonals.clear();
+
+		const auto addRing = [&](const std::vector<Point2D<T>>& ring, bool counterClockwise) {
+			const uint32_t first = static_cast<uint32_t>(fVertices.size());
+			const uint32_t count = static_cast<uint32_t>(ring.size());
+
+			double area = 0;
+			for (uint32_t point = 0; point < count; point++) {
+				const Point2D<T>& current = ring[point];
+				const Point2D<T>& next = ring[(point + 1) % count];
+				area += (double(current.x) * double(next.y)) - (double(next.x) * double(current.y));
+				fVertices.push_back({double(current.x), double(current.y)});
+			}
+
+			// Rings too small to enclose anything are skipped, but keep their slots
+			const bool usable = count >= 3;
+			const bool reverse = (area > 0) != counterClockwise;
+			for (uint32_t point = 0; point < count; point++) {
+				uint32_t next = first + ((point + 1) % count);
+				uint32_t previous = first + ((point + count - 1) % count);
+				if (reverse)
+					std::swap(next, previous);
+
+				fNext.push_back(usable ? next : kNone);
+				fPrevious.push_back(usable ? previous : kNone);
+			}
+		};
+
+		addRing(polygon.outline, true);
+		for (const std::vector<Point2D<T>>& hole : polygon.holes)
+			addRing(hole, false);
+
+		return true;
+	}
+
+	// The sweep-line status: edges with the interior to their right, left to right
+	struct SweepPoint {
+		double x;
+		double y;
+	};
+
+	struct EdgeOrder {
+		using is_transparent = void;
+
+		const PolygonTriangulator* owner;
+		const SweepPoint* sweep;
+
+		bool
+		operator()(uint32_t a, uint32_t b) const
+		{
+			if (a == b)
+				return false;
+
+			const double xA = owner->edgeX(a, sweep->y, sweep->x);
+			const double xB = owner->edgeX(b, sweep->y, sweep->x);
+			if (xA != xB)
+				return xA < xB;
+
+			// Edges meeting at the sweep line are ordered by where they go next
+			const double lowerY = std::max(owner->fVertices[owner->fNext[a]].y, owner->fVertices[owner->fNext[b]].y);
+			if (lowerY < sweep->y) {
+				const double lowerXA = owner->edgeX(a, lowerY, sweep->x);
+				const double lowerXB = owner->edgeX(b, lowerY, sweep->x);
+				if (lowerXA != lowerXB)
+					return lowerXA < lowerXB;
+			}
+
+			return a < b;
+		}
+
+		bool operator()(const SweepPoint& point, uint32_t edge) const { return point.x < owner->edgeX(edge, point.y, point.x); }
+
+		bool operator()(uint32_t edge, const SweepPoint& point) const { return owner->edgeX(edge, point.y, point.x) < point.x; }
+	};
+
+	// Where the edge starting at 'edge' crosses the line at 'y'
+	[[nodiscard]] double
+	edgeX(uint32_t edge, double y, double sweepX) const
+	{
+		const Vertex& upper = fVertices[edge];
+		const Vertex& lower = fVertices[fNext[edge]];
+
+		if (upper.y == lower.y)
+			return std::clamp(sweepX, std::min(upper.x, lower.x), std::max(upper.x, lower.x));
+
+		if (y >= upper.y)
+			return upper.x;
+		if (y <= lower.y)
+			return lower.x;
+
+		const double t = (upper.y - y) / (upper.y - lower.y);
+		return upper.x + (t * (lower.x - upper.x));
+	}
+
+	[[nodiscard]] VertexType
+	classify(uint32_t vertex) const
+	{
+		const uint32_t previous = fPrevious[vertex];
+		const uint32_t next = fNext[vertex];
+		const bool previousAbove = above(previous, vertex);
+		const bool nextAbove = above(next, vertex);
+		const bool convex = cross(fVertices[previous], fVertices[vertex], fVertices[next]) > 0;
+
+		if (!previousAbove && !nextAbove)
+			return convex ? VertexType::kStart : VertexType::kSplit;
+		if (previousAbove && nextAbove)
+			return convex ? VertexType::kEnd : VertexType::kMerge;
+
+		return VertexType::kRegular;
+	}
+
+	// Step 1: the sweep
+	bool
+	addDiagonals()
+	{
+		const uint32_t vertexCount = static_cast<uint32_t>(fVertices.size());
+
+		fOrder.clear();
+		for (uint32_t vertex = 0; vertex < vertexCount; vertex++) {
+			if (fNext[vertex] != kNone)
+				fOrder.push_back(vertex);
+		}
+
+		std::sort(fOrder.begin(), fOrder.end(), [this](uint32_t a, uint32_t b) { return above(a, b); });
+
+		fTypes.resize(vertexCount);
+		for (uint32_t vertex : fOrder)
+			fTypes[vertex] = classify(vertex);
+
+		SweepPoint sweep{0, 0};
+		using Status = std::set<uint32_t, EdgeOrder>;
+		Status status(EdgeOrder{this, &sweep});
+
+		// Each edge's place in the status, and the vertex a diagonal from below would go to
+		std::vector<typename Status::iterator> places(vertexCount, status.end());
+		fHelpers.assign(vertexCount, kNone);
+
+		const auto insert = [&](uint32_t edge) {
+			places[edge] = status.insert(edge).first;
+			fHelpers[edge] = edge;
+		};
+
+		const auto remove = [&](uint32_t edge) {
+			if (places[edge] != status.end()) {
+				status.erase(places[edge]);
+				places[edge] = status.end();
+			}
+		};
+
+		// The edge directly left of 'vertex', if any
+		const auto leftOf = [&](uint32_t vertex) {
+			auto edge = status.upper_bound(SweepPoint{fVertices[vertex].x, fVertices[vertex].y});
+			return (edge == status.begin()) ? kNone : *std::prev(edge);
+		};
+
+		const auto connectToMergeHelper = [&](uint32_t vertex, uint32_t edge) {
+			if (edge != kNone && fHelpers[edge] != kNone && fTypes[fHelpers[edge]] == VertexType::kMerge)
+				fDiagonals.emplace_back(vertex, fHelpers[edge]);
+		};
+
+		for (uint32_t vertex : fOrder) {
+			sweep = {fVertices[vertex].x, fVertices[vertex].y};
+			const uint32_t previousEdge = fPrevious[vertex];
+
+			switch (fTypes[vertex]) {
+				case VertexType::kStart:
+					insert(vertex);
+					break;
+
+				case VertexType::kEnd:
+					connectToMergeHelper(vertex, previousEdge);
+					remove(previousEdge);
+					break;
+
+				case VertexType::kSplit: {
+					const uint32_t left = leftOf(vertex);
+					if (left == kNone)
+						return false;
+
+					fDiagonals.emplace_back(vertex, fHelpers[left]);
+					fHelpers[left] = vertex;
+					insert(vertex);
+					break;
+				}
+
+				case VertexType::kMerge: {
+					connectToMergeHelper(vertex, previousEdge);
+					remove(previousEdge);
+
+					const uint32_t left = leftOf(vertex);
+					if (left == kNone)
+						return false;
+
+					connectToMergeHelper(vertex, left);
+					fHelpers[left] = vertex;
+					break;
+				}
+
+				case VertexType::kRegular:
+					// The interior is right of a vertex on a descending chain
+					if (above(fPrevious[vertex], vertex)) {
+						connectToMergeHelper(vertex, previousEdge);
+						remove(previousEdge);
+						insert(vertex);
+					} else {
+						const uint32_t left = leftOf(vertex);
+						if (left == kNone)
+							return false;
+
+						connectToMergeHelper(vertex, left);
+						fHelpers[left] = vertex;
+					}
+					break;
+			}
+		}
+
+		return true;
+	}
+
+	// Steps 2 and 3: walk out each monotone piece and triangulate it
+	bool
+	triangulatePieces(std::vector<uint32_t>& indices)
+	{
+		const uint32_t vertexCount = static_cast<uint32_t>(fVertices.size());
+
+		// Neighbors of every vertex, counter-clockwise by angle
+		fOffsets.assign(vertexCount + 1, 0);
+		for (uint32_t vertex = 0; vertex < vertexCount; vertex++) {
+			if (fNext[vertex] != kNone)
+				fOffsets[vertex + 1] += 2;
+		}
+		for (const auto& [from, to] : fDiagonals) {
+			fOffsets[from + 1]++;
+			fOffsets[to + 1]++;
+		}
+		std::partial_sum(fOffsets.begin(), fOffsets.end(), fOffsets.begin());
+
+		fNeighbors.resize(fOffsets[vertexCount]);
+		{
+			std::vector<uint32_t> fill(fOffsets.begin(), fOffsets.end() - 1);
+			for (uint32_t vertex = 0; vertex < vertexCount; vertex++) {
+				if (fNext[vertex] != kNone) {
+					fNeighbors[fill[vertex]++] = fNext[vertex];
+					fNeighbors[fill[vertex]++] = fPrevious[vertex];
+				}
+			}
+			for (const auto& [from, to] : fDiagonals) {
+				fNeighbors[fill[from]++] = to;
+				fNeighbors[fill[to]++] = from;
+			}
+		}
+
+		for (uint32_t vertex = 0; vertex < vertexCount; vertex++) {
+			const Vertex& center = fVertices[vertex];
+			std::sort(fNeighbors.begin() + fOffsets[vertex], fNeighbors.begin() + fOffsets[vertex + 1],
+				[&](uint32_t a, uint32_t b) {
+					return std::atan2(fVertices[a].y - center.y, fVertices[a].x - center.x)
+						< std::atan2(fVertices[b].y - center.y, fVertices[b].x - center.x);
+				});
+		}
+
+		// Each half-edge's twin, found by sorting the half-edges by their endpoints
+		const uint32_t halfEdgeCount = fOffsets[vertexCount];
+		fTwins.resize(halfEdgeCount);
+		{
+			std::vector<std::pair<uint64_t, uint32_t>> keys;
+			keys.reserve(halfEdgeCount);
+			for (uint32_t vertex = 0; vertex < vertexCount; vertex++) {
+				for (uint32_t slot = fOffsets[vertex]; slot < fOffsets[vertex + 1]; slot++) {
+					const uint32_t neighbor = fNeighbors[slot];
+					const uint64_t key = (uint64_t(std::min(vertex, neighbor)) << 32) | std::max(vertex, neighbor);
+					keys.emplace_back(key, slot);
+				}
+			}
+
+			std::sort(keys.begin(), keys.end());
+			for (uint32_t key = 0; key + 1 < halfEdgeCount; key += 2) {
+				if (keys[key].first != keys[key + 1].first)
+					return false;
+
+				fTwins[keys[key].second] = keys[key + 1].second;
+				fTwins[keys[key + 1].second] = keys[key].second;
+			}
+		}
+
+		// The vertex each half-edge leaves from
+		fOrigins.resize(halfEdgeCount);
+		for (uint32_t vertex = 0; vertex < vertexCount; vertex++)
+			std::fill(fOrigins.begin() + fOffsets[vertex], fOrigins.begin() + fOffsets[vertex + 1], vertex);
+
+		// Every half-edge with the interior on its left bounds one piece
+		fVisited.assign(halfEdgeCount, 0);
+		for (uint32_t start = 0; start < halfEdgeCount; start++) {
+			const uint32_t origin = fOrigins[start];
+			if (fVisited[start] || fNeighbors[start] == fPrevious[origin])
+				continue;
+
+			fPiece.clear();
+			uint32_t halfEdge = start;
+			do {
+				if (fVisited[halfEdge] || fPiece.size() > vertexCount)
+					return false;
+
+				fVisited[halfEdge] = 1;
+				fPiece.push_back(fOrigins[halfEdge]);
+
+				// Turn as far right as possible: the neighbor before the one we came from
+				const uint32_t twin = fTwins[halfEdge];
+				const uint32_t destination = fOrigins[twin];
+				halfEdge = (twin == fOffsets[destination]) ? fOffsets[destination + 1] - 1 : twin - 1;
+			} while (halfEdge != start);
+
+			triangulateMonotone(indices);
+		}
+
+		return true;
+	}
+
+	// Triangulates fPiece, a y-monotone polygon in counter-clockwise order
+	void
+	triangulateMonotone(std::vector<uint32_t>& indices)
+	{
+		const size_t count = fPiece.size();
+		if (count < 3)
+			return;
+
+		const auto emit = [&](uint32_t a, uint32_t b, uint32_t c) {
+			const double area = cross(fVertices[a], fVertices[b], fVertices[c]);
+			if (area == 0)
+				return;
+
+			if (area < 0)
+				std::swap(b, c);
+
+			indices.insert(indices.end(), {a, b, c});
+		};
+
+		if (count == 3) {
+			emit(fPiece[0], fPiece[1], fPiece[2]);
+			return;
+		}
+
+		// Counter-clockwise from the top is the left chain, down to the bottom
+		size_t top = 0;
+		size_t bottom = 0;
+		for (size_t corner = 1; corner < count; corner++) {
+			if (above(fPiece[corner], fPiece[top]))
+				top = corner;
+			if (above(fPiece[bottom], fPiece[corner]))
+				bottom = corner;
+		}
+
+		// Merge the two chains into sweep order, remembering which side each vertex is on
+		fSorted.clear();
+		size_t left = top;
+		size_t right = top;
+		fSorted.emplace_back(fPiece[top], true);
+		while (fSorted.size() < count) {
+			// The bottom vertex ends the left chain
+			const size_t nextLeft = (left + 1) % count;
+			const size_t nextRight = (right + count - 1) % count;
+			const bool leftAvailable = left != bottom;
+			const bool rightAvailable = nextRight != bottom;
+
+			if (leftAvailable && (!rightAvailable || above(fPiece[nextLeft], fPiece[nextRight]))) {
+				left = nextLeft;
+				fSorted.emplace_back(fPiece[left], true);
+			} else {
+				right = nextRight;
+				fSorted.emplace_back(fPiece[right], false);
+			}
+		}
+
+		fStack.clear();
+		fStack.push_back(fSorted[0]);
+		fStack.push_back(fSorted[1]);
+
+		for (size_t corner = 2; corner + 1 < count; corner++) {
+			const auto [vertex, onLeft] = fSorted[corner];
+
+			if (onLeft != fStack.back().second) {
+				// Opposite chains: fan to everything on the stack
+				for (size_t entry = 0; entry + 1 < fStack.size(); entry++)
+					emit(vertex, fStack[entry].first, fStack[entry + 1].first);
+
+				const std::pair<uint32_t, bool> previous = fStack.back();
+				fStack.clear();
+				fStack.push_back(previous);
+				fStack.emplace_back(vertex, onLeft);
+			} else {
+				// Same chain: cut off corners while the diagonal stays inside
+				std::pair<uint32_t, bool> last = fStack.back();
+				fStack.pop_back();
+				while (!fStack.empty()) {
+					const double turn = cross(fVertices[fStack.back().first], fVertices[last.first], fVertices[vertex]);
+					if (onLeft ? turn <= 0 : turn >= 0)
+						break;
+
+					emit(vertex, last.first, fStack.back().first);
+					last = fStack.back();
+					fStack.pop_back();
+				}
+
+				fStack.push_back(last);
+				fStack.emplace_back(vertex, onLeft);
+			}
+		}
+
+		const uint32_t lowest = fSorted[count - 1].first;
+		for (size_t entry = 0; entry + 1 < fStack.size(); entry++)
+			emit(lowest, fStack[entry].first, fStack[entry + 1].first);
+	}
+
+private:
+	std::vector<Vertex> fVertices;
+	std::vector<uint32_t> fNext;
+	std::vector<uint32_t> fPrevious;
+
+	// Sweep
+	std::vector<uint32_t> fOrder;
+	std::vector<VertexType> fTypes;
+	std::vector<uint32_t> fHelpers;
+	std::vector<std::pair<uint32_t, uint32_t>> fDiagonals;
+
+	// Planar graph of edges and diagonals
+	std::vector<uint32_t> fOffsets;
+	std::vector<uint32_t> fNeighbors;
+	std::vector<uint32_t> fTwins;
+	std::vector<uint32_t> fOrigins;
+	std::vector<uint8_t> fVisited;
+
+	// Current monotone piece
+	std::vector<uint32_t> fPiece;
+	std::vector<std::pair<uint32_t, bool>> fSorted;
+	std::vector<std::pair<uint32_t, bool>> fStack;
+};
+
+
+// Description: Triangulates every polygon in 'polygons' on 'threadCount'
+// threads (0 for every hardware thread).
+// 	- Returns one index list per polygon, see PolygonTriangulator. A polygon
+// 	  that can't be triangulated gets an empty list.
+// 	- Threads take polygons in small batches from a shared counter, so a few
+// 	  large polygons don't hold up the rest.
+template<typename T>
+static inline std::vector<std::vector<uint32_t>>
+TriangulatePolygons(std::span<const Polygon2D<T>> polygons, unsigned threadCount = 0)
+{
+	static constexpr size_t kBatchSize = 16;
+
+	std::vector<std::vector<uint32_t>> results(polygons.size());
+
+	if (threadCount == 0)
+		threadCount = std::max(1u, std::thread::hardware_concurrency());
+	threadCount = static_cast<unsigned>(std::min<size_t>(threadCount, (polygons.size() + kBatchSize - 1) / kBatchSize));
+
+	std::atomic<size_t> nextPolygon = 0;
+	const auto work = [&]() {
+		PolygonTriangulator<T> triangulator;
+		for (;;) {
+			const size_t first = nextPolygon.fetch_add(kBatchSize, std::memory_order_relaxed);
+			if (first >= polygons.size())
+				break;
+
+			const size_t last = std::min(first + kBatchSize, polygons.size());
+			for (size_t polygon = first; polygon < last; polygon++)
+				triangulator.Triangulate(polygons[polygon], results[polygon]);
+		}
+	};
+
+	std::vector<std::thread> threads;
+	for (unsigned thread = 1; thread < threadCount; thread++)
+		threads.emplace_back(work);
+
+	work();
+
+	for (std::thread& thread : threads)
+		thread.join();
+
+	return results;
+}
+
+
+#endif //HW2A_TRIANGULATOR_HPP
@@ -6,6 +6,8 @@
 #include <cmath>
 #include <iostream>
 
+#include "ConstexprMath.hpp"
+
 template<typename T>
 struct Vector3D {
 	T dx;
@@ -15,7 +17,7 @@ struct Vector3D {
 public:
 	Vector3D() = default;
 
-	Vector3D(T dx, T dy, T dz)
+	constexpr Vector3D(T dx, T dy, T dz)
 			:
 			dx(dx),
 			dy(dy),
@@ -31,14 +33,14 @@ public:
 //	}
 
 	// Description: Calculates the length of this vector.
-	[[nodiscard]] inline T
+	[[nodiscard]] constexpr T
 	Length() const {
-		return sqrt((dx * dx) + (dy * dy) + (dz * dz));
+		return ConstexprMath::Sqrt((dx * dx) + (dy * dy) + (dz * dz));
 	}
 
 	// Description: Converts this vector into a unit vector.
 	// 	- This is a vector with length 1, though with the same direction.
-	void
+	constexpr void
 	NormalizeSelf() {
 		T vectorLength = Length();
 		// We can't divide by zero!!!
@@ -54,7 +56,7 @@ public:
 
 	// Description: Calculates the unit vector of this vector and returns it.
 	// 	- This is a vector with length 1, though with the same direction.
-	[[nodiscard]] Vector3D<T>
+	[[nodiscard]] constexpr Vector3D<T>
 	Normalize() const {
 		Vector3D<T> norm = *this;
 		norm.NormalizeSelf();
@@ -63,13 +65,13 @@ public:
 
 	// Description: Obtain angle between directions of this vector and 'v'.
 	// 	- Note: Vectors are Orthogonal when Dot Product == 0.
-	[[nodiscard]] T
+	[[nodiscard]] constexpr T
 	DotProduct(const Vector3D& v) const {
 		return (dx * v.dx) + (dy * v.dy) + (dz * v.dz);
 	}
 
 	// Description: Finds the vector normal/perpendicular to this Vector 3D and 'v'.
-	[[nodiscard]] Vector3D<T>
+	[[nodiscard]] constexpr Vector3D<T>
 	CrossProduct(const Vector3D<T>& v) const {
 		Vector3D normal{};
 
@@ -110,7 +112,7 @@ public:
 		return *this;
 	}
 
-	auto operator<=>(const Vector3D<T>& other) const = default;
+	constexpr auto operator<=>(const Vector3D<T>& other) const = default;
 };
 
 /** Types */
@@ -120,7 +122,7 @@ using Vector3Df = Vector3D<float>;
 
 /** Extra Operators */
 
-template<typename T> static Vector3D<T>
+template<typename T> static constexpr Vector3D<T>
 operator*(const Vector3D<T>& vector, const T& scalar)
 {
 	Vector3D scaledVector = vector;
@@ -128,7 +130,7 @@ operator*(const Vector3D<T>& vector, const T& scalar)
 	return scaledVector;
 }
 
-template<typename T> static Vector3D<T>
+template<typename T> static constexpr Vector3D<T>
 operator+(const Vector3D<T>& vectorA, const Vector3D<T>& vectorB)
 {
 	Vector3D<T> vectorC{};
@@ -140,7 +142,7 @@ operator+(const Vector3D<T>& vectorA, const Vector3D<T>& vectorB)
 	return vectorC;
 }
 
-template<typename T> static Vector3D<T>
+template<typename T> static constexpr Vector3D<T>
 operator-(const Vector3D<T>& vectorA, const Vector3D<T>& vectorB)
 {
 	Vector3D vectorC = vectorA;
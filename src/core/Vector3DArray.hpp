@@ -0,0 +1,357 @@
+// Assignment 2a - Programming Interactive 2D Graphics with OpenGL
+// Work by Jacob Secunda
+#ifndef HW2A_VECTOR3DARRAY_HPP
+#define HW2A_VECTOR3DARRAY_HPP
+
+#include <algorithm>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include "MatrixKernels.hpp"
+#include "Vector3D.hpp"
+
+// How NormalizeAll() computes 1 / length. The bounds are on each component's
+// distance from the exact unit vector (checked by Vector3DArrayTest.cpp).
+enum class NormalizeAccuracy {
+	kExact,			// Divides by the square root, same results as Vector3D::NormalizeSelf() (2^-22)
+	kFast,			// Reciprocal square root estimate plus one Newton-Raphson step (2^-21)
+	kApproximate	// Reciprocal square root estimate only (2^-11)
+};
+
+
+namespace Vector3DArrayDetail {
+
+// A register's worth of floats, so each kernel below is written once for
+// AVX (8 lanes) or SSE2 (4 lanes)
+#if HW2A_HAVE_AVX
+struct FloatBatch {
+	static constexpr size_t kWidth = 8;
+	__m256 value;
+
+	static FloatBatch Load(const float* data) { return {_mm256_loadu_ps(data)}; }
+	static FloatBatch Broadcast(float scalar) { return {_mm256_set1_ps(scalar)}; }
+	void Store(float* data) const { _mm256_storeu_ps(data, value); }
+
+	friend FloatBatch operator+(FloatBatch a, FloatBatch b) { return {_mm256_add_ps(a.value, b.value)}; }
+	friend FloatBatch operator-(FloatBatch a, FloatBatch b) { return {_mm256_sub_ps(a.value, b.value)}; }
+	friend FloatBatch operator*(FloatBatch a, FloatBatch b) { return {_mm256_mul_ps(a.value, b.value)}; }
+	friend FloatBatch operator/(FloatBatch a, FloatBatch b) { return {_mm256_div_ps(a.value, b.value)}; }
+
+	static FloatBatch Sqrt(FloatBatch a) { return {_mm256_sqrt_ps(a.value)}; }
+	static FloatBatch ReciprocalSqrt(FloatBatch a) { return {_mm256_rsqrt_ps(a.value)}; }
+
+	// Lanes of 'a' where 'reference' is zero, lanes of 'b' elsewhere
+	static FloatBatch
+	SelectIfZero(FloatBatch reference, FloatBatch a, FloatBatch b)
+	{
+		const __m256 mask = _mm256_cmp_ps(reference.value, _mm256_setzero_ps(), _CMP_EQ_OQ);
+		return {_mm256_blendv_ps(b.value, a.value, mask)};
+	}
+};
+#define HW2A_HAVE_FLOAT_BATCH 1
+#elif HW2A_HAVE_SSE2
+struct FloatBatch {
+	static constexpr size_t kWidth = 4;
+	__m128 value;
+
+	static FloatBatch Load(const float* data) { return {_mm_loadu_ps(data)}; }
+	static FloatBatch Broadcast(float scalar) { return {_mm_set1_ps(scalar)}; }
+	void Store(float* data) const { _mm_storeu_ps(data, value); }
+
+	friend FloatBatch operator+(FloatBatch a, FloatBatch b) { return {_mm_add_ps(a.value, b.value)}; }
+	friend FloatBatch operator-(FloatBatch a, FloatBatch b) { return {_mm_sub_ps(a.value, b.value)}; }
+	friend FloatBatch operator*(FloatBatch a, FloatBatch b) { return {_mm_mul_ps(a.value, b.value)}; }
+	friend FloatBatch operator/(FloatBatch a, FloatBatch b) { return {_mm_div_ps(a.value, b.value)}; }
+
+	static FloatBatch Sqrt(FloatBatch a) { return {_mm_sqrt_ps(a.value)}; }
+	static FloatBatch ReciprocalSqrt(FloatBatch a) { return {_mm_rsqrt_ps(a.value)}; }
+
+	static FloatBatch
+	SelectIfZero(FloatBatch reference, FloatBatch a, FloatBatch b)
+	{
+		const __m128 mask = _mm_cmpeq_ps(reference.value, _mm_setzero_ps());
+		return {_mm_or_ps(_mm_and_ps(mask, a.value), _mm_andnot_ps(mask, b.value))};
+	}
+};
+#define HW2A_HAVE_FLOAT_BATCH 1
+#endif
+
+} // namespace Vector3DArrayDetail
+
+
+// Vector3Ds stored as three separate component arrays (structure of arrays),
+// with bulk operations that run over whole registers of components at once
+// for float, and one vector at a time otherwise.
+template<typename T>
+class Vector3DArray {
+public:
+	Vector3DArray() = default;
+
+	explicit Vector3DArray(size_t count)
+	{
+		Resize(count);
+	}
+
+	explicit Vector3DArray(std::span<const Vector3D<T>> vectors)
+	{
+		Reserve(vectors.size());
+		for (const Vector3D<T>& vector : vectors)
+			PushBack(vector);
+	}
+
+	[[nodiscard]] size_t Size() const { return fDX.size(); }
+
+	void
+	Resize(size_t count)
+	{
+		fDX.resize(count);
+		fDY.resize(count);
+		fDZ.resize(count);
+	}
+
+	void
+	Reserve(size_t count)
+	{
+		fDX.reserve(count);
+		fDY.reserve(count);
+		fDZ.reserve(count);
+	}
+
+	void
+	PushBack(const Vector3D<T>& vector)
+	{
+		fDX.push_back(vector.dx);
+		fDY.push_back(vector.dy);
+		fDZ.push_back(vector.dz);
+	}
+
+	[[nodiscard]] Vector3D<T> Get(size_t index) const { return {fDX[index], fDY[index], fDZ[index]}; }
+
+	void
+	Set(size_t index, const Vector3D<T>& vector)
+	{
+		fDX[index] = vector.dx;
+		fDY[index] = vector.dy;
+		fDZ[index] = vector.dz;
+	}
+
+	// Component arrays
+	[[nodiscard]] std::span<T> DX() { return fDX; }
+	[[nodiscard]] std::span<T> DY() { return fDY; }
+	[[nodiscard]] std::span<T> DZ() { return fDZ; }
+	[[nodiscard]] std::span<const T> DX() const { return fDX; }
+	[[nodiscard]] std::span<const T> DY() const { return fDY; }
+	[[nodiscard]] std::span<const T> DZ() const { return fDZ; }
+
+
+	/** Bulk Operations */
+	// Each writes min(Size(), output size) results.
+
+	// Description: Calculates the length of every vector.
+	void
+	Lengths(std::span<T> out) const
+	{
+		const size_t count = std::min(Size(), out.size());
+		size_t index = 0;
+
+#if HW2A_HAVE_FLOAT_BATCH
+		if constexpr (std::is_same_v<T, float>) {
+			using Batch = Vector3DArrayDetail::FloatBatch;
+			for (; index + Batch::kWidth <= count; index += Batch::kWidth) {
+				const Batch dx = Batch::Load(&fDX[index]);
+				const Batch dy = Batch::Load(&fDY[index]);
+				const Batch dz = Batch::Load(&fDZ[index]);
+				Batch::Sqrt((dx * dx) + (dy * dy) + (dz * dz)).Store(&out[index]);
+			}
+		}
+#endif
+
+		for (; index < count; index++)
+			out[index] = Get(index).Length();
+	}
+
+	// Description: Converts every vector into a unit vector; zero-length vectors are left alone.
+	void
+	NormalizeAll(NormalizeAccuracy accuracy = NormalizeAccuracy::kExact)
+	{
+		const size_t count = Size();
+		size_t index = 0;
+
+#if HW2A_HAVE_FLOAT_BATCH
+		if constexpr (std::is_same_v<T, float>) {
+			using Batch = Vector3DArrayDetail::FloatBatch;
+			const Batch one = Batch::Broadcast(1.f);
+			const Batch half = Batch::Broadcast(0.5f);
+			const Batch threeHalves = Batch::Broadcast(1.5f);
+
+			for (; index + Batch::kWidth <= count; index += Batch::kWidth) {
+				Batch dx = Batch::Load(&fDX[index]);
+				Batch dy = Batch::Load(&fDY[index]);
+				Batch dz = Batch::Load(&fDZ[index]);
+				const Batch lengthSquared = (dx * dx) + (dy * dy) + (dz * dz);
+
+				if (accuracy == NormalizeAccuracy::kExact) {
+					// Dividing (rather than multiplying by 1 / length) matches NormalizeSelf()
+					const Batch length = Batch::SelectIfZero(lengthSquared, one, Batch::Sqrt(lengthSquared));
+					dx = dx / length;
+					dy = dy / length;
+					dz = dz / length;
+				} else {
+					Batch inverseLength = Batch::ReciprocalSqrt(lengthSquared);
+					if (accuracy == NormalizeAccuracy::kFast) {
+						// y' = y * (1.5 - 0.5 * x * y * y)
+						inverseLength = inverseLength
+							* (threeHalves - (half * lengthSquared * inverseLength * inverseLength));
+					}
+
+					inverseLength = Batch::SelectIfZero(lengthSquared, one, inverseLength);
+					dx = dx * inverseLength;
+					dy = dy * inverseLength;
+					dz = dz * inverseLength;
+				}
+
+				dx.Store(&fDX[index]);
+				dy.Store(&fDY[index]);
+				dz.Store(&fDZ[index]);
+			}
+		}
+#endif
+
+		for (; index < count; index++)
+			Set(index, Get(index).Normalize());
+	}
+
+	// Description: Dot product of every vector with 'vector'.
+	void
+	Dot(const Vector3D<T>& vector, std::span<T> out) const
+	{
+		const size_t count = std::min(Size(), out.size());
+		size_t index = 0;
+
+#if HW2A_HAVE_FLOAT_BATCH
+		if constexpr (std::is_same_v<T, float>) {
+			using Batch = Vector3DArrayDetail::FloatBatch;
+			const Batch vx = Batch::Broadcast(vector.dx);
+			const Batch vy = Batch::Broadcast(vector.dy);
+			const Batch vz = Batch::Broadcast(vector.dz);
+
+			for (; index + Batch::kWidth <= count; index += Batch::kWidth) {
+				const Batch result = (Batch::Load(&fDX[index]) * vx) + (Batch::Load(&fDY[index]) * vy)
+					+ (Batch::Load(&fDZ[index]) * vz);
+				result.Store(&out[index]);
+			}
+		}
+#endif
+
+		for (; index < count; index++)
+			out[index] = Get(index).DotProduct(vector);
+	}
+
+	// Description: Pairwise dot product of the vectors in this array and 'other'.
+	void
+	Dot(const Vector3DArray& other, std::span<T> out) const
+	{
+		const size_t count = std::min({Size(), other.Size(), out.size()});
+		size_t index = 0;
+
+#if HW2A_HAVE_FLOAT_BATCH
+		if constexpr (std::is_same_v<T, float>) {
+			using Batch = Vector3DArrayDetail::FloatBatch;
+			for (; index + Batch::kWidth <= count; index += Batch::kWidth) {
+				const Batch result = (Batch::Load(&fDX[index]) * Batch::Load(&other.fDX[index]))
+					+ (Batch::Load(&fDY[index]) * Batch::Load(&other.fDY[index]))
+					+ (Batch::Load(&fDZ[index]) * Batch::Load(&other.fDZ[index]));
+				result.Store(&out[index]);
+			}
+		}
+#endif
+
+		for (; index < count; index++)
+			out[index] = Get(index).DotProduct(other.Get(index));
+	}
+
+	// Description: Cross product of every vector with 'vector'; 'out' is resized to fit.
+	void
+	Cross(const Vector3D<T>& vector, Vector3DArray& out) const
+	{
+		out.Resize(Size());
+		crossInto(out, &vector.dx, &vector.dy, &vector.dz, 0);
+	}
+
+	// Description: Pairwise cross product of the vectors in this array and 'other'.
+	void
+	Cross(const Vector3DArray& other, Vector3DArray& out) const
+	{
+		out.Resize(std::min(Size(), other.Size()));
+		crossInto(out, other.fDX.data(), other.fDY.data(), other.fDZ.data(), 1);
+	}
+
+	// Description: Lengthen/shorten every vector by 'scalar' amount.
+	void
+	Scale(const T& scalar)
+	{
+		for (std::vector<T>* components : {&fDX, &fDY, &fDZ}) {
+			T* data = components->data();
+			const size_t count = components->size();
+			size_t index = 0;
+
+#if HW2A_HAVE_FLOAT_BATCH
+			if constexpr (std::is_same_v<T, float>) {
+				using Batch = Vector3DArrayDetail::FloatBatch;
+				const Batch factor = Batch::Broadcast(scalar);
+				for (; index + Batch::kWidth <= count; index += Batch::kWidth)
+					(Batch::Load(data + index) * factor).Store(data + index);
+			}
+#endif
+
+			for (; index < count; index++)
+				data[index] *= scalar;
+		}
+	}
+
+private:
+	// The right-hand vector of 'index' is at 'index * otherStride' in the
+	// other* arrays, so a stride of 0 crosses everything with one vector
+	void
+	crossInto(Vector3DArray& out, const T* otherX, const T* otherY, const T* otherZ, size_t otherStride) const
+	{
+		const size_t count = out.Size();
+		size_t index = 0;
+
+#if HW2A_HAVE_FLOAT_BATCH
+		if constexpr (std::is_same_v<T, float>) {
+			using Batch = Vector3DArrayDetail::FloatBatch;
+			const auto other = [otherStride](const float* data, size_t at) {
+				return (otherStride == 0) ? Batch::Broadcast(*data) : Batch::Load(data + at);
+			};
+
+			for (; index + Batch::kWidth <= count; index += Batch::kWidth) {
+				const Batch ax = Batch::Load(&fDX[index]), bx = other(otherX, index);
+				const Batch ay = Batch::Load(&fDY[index]), by = other(otherY, index);
+				const Batch az = Batch::Load(&fDZ[index]), bz = other(otherZ, index);
+
+				((ay * bz) - (az * by)).Store(&out.fDX[index]);
+				((az * bx) - (ax * bz)).Store(&out.fDY[index]);
+				((ax * by) - (ay * bx)).Store(&out.fDZ[index]);
+			}
+		}
+#endif
+
+		for (; index < count; index++) {
+			const size_t at = index * otherStride;
+			out.Set(index, Get(index).CrossProduct({otherX[at], otherY[at], otherZ[at]}));
+		}
+	}
+
+private:
+	std::vector<T> fDX;
+	std::vector<T> fDY;
+	std::vector<T> fDZ;
+};
+
+/** Types */
+using Vector3DArrayf = Vector3DArray<float>;
+
+
+#endif //HW2A_VECTOR3DARRAY_HPP
@@ -0,0 +1,134 @@
+// Assignment 2a - Programming Interactive 2D Graphics with OpenGL
+// Work by Jacob Secunda
+#ifndef HW2A_VERTEXFORMAT_HPP
+#define HW2A_VERTEXFORMAT_HPP
+
+#include "glad/glad.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "MeshFile.hpp"
+#include "Model.hpp"
+
+// How a Model's vertices are laid out in a vertex buffer.
+//
+// 	- Planar keeps all positions, then all colors (the original upload).
+// 	- Interleaved stores each vertex's position and color side by side, so
+// 	  one vertex fetch touches one cache line instead of two.
+// 	- Colors are either three floats or four normalized bytes (RGBA8, alpha
+// 	  255). Packed (interleaved RGBA8) takes 12 bytes per vertex instead of 20.
+//
+// Attributes() describes the layout for glVertexAttribPointer() and for
+// mesh files, Pack() produces the matching bytes.
+struct VertexFormat {
+	enum class Layout {
+		kPlanar,
+		kInterleaved
+	};
+
+	enum class ColorEncoding {
+		kFloat3,
+		kUnorm8x4
+	};
+
+	Layout layout = Layout::kInterleaved;
+	ColorEncoding color = ColorEncoding::kUnorm8x4;
+
+public:
+	static constexpr VertexFormat Planar() { return {Layout::kPlanar, ColorEncoding::kFloat3}; }
+
+	static constexpr VertexFormat Packed() { return {Layout::kInterleaved, ColorEncoding::kUnorm8x4}; }
+
+	[[nodiscard]] static constexpr size_t PositionSize() { return sizeof(FloatType2D); }
+
+	[[nodiscard]] constexpr size_t
+	ColorSize() const
+	{
+		return (color == ColorEncoding::kFloat3) ? sizeof(ColorType3D) : 4 * sizeof(GLubyte);
+	}
+
+	[[nodiscard]] constexpr size_t VertexSize() const { return PositionSize() + ColorSize(); }
+
+	// Description: Describes where each attribute of 'vertexCount' vertices lives.
+	[[nodiscard]] std::vector<MeshFile::AttributeDescriptor>
+	Attributes(size_t vertexCount) const
+	{
+		MeshFile::AttributeDescriptor position{uint32_t(MeshFile::Semantic::kPosition), 2, GL_FLOAT, GL_FALSE, 0, 0};
+		MeshFile::AttributeDescriptor colors{uint32_t(MeshFile::Semantic::kColor), 3, GL_FLOAT, GL_FALSE, 0, 0};
+		if (color == ColorEncoding::kUnorm8x4) {
+			colors.componentCount = 4;
+			colors.componentType = GL_UNSIGNED_BYTE;
+			colors.normalized = GL_TRUE;
+		}
+
+		if (layout == Layout::kInterleaved) {
+			position.stride = colors.stride = static_cast<uint32_t>(VertexSize());
+			colors.offset = static_cast<uint32_t>(PositionSize());
+		} else {
+			colors.offset = static_cast<uint32_t>(vertexCount * PositionSize());
+		}
+
+		return {position, colors};
+	}
+
+	// Description: Writes the vertices of 'model' to 'destination', which
+	// must hold VertexSize() * model.VertexCount() bytes.
+	void
+	Pack(const Model& model, std::byte* destination) const
+	{
+		const size_t vertexCount = model.VertexCount();
+
+		if (layout == Layout::kPlanar) {
+			memcpy(destination, model.vertices.data(), vertexCount * PositionSize());
+			destination += vertexCount * PositionSize();
+
+			for (size_t vertex = 0; vertex < vertexCount; vertex++, destination += ColorSize())
+				packColor(model.colors[vertex], destination);
+
+			return;
+		}
+
+		for (size_t vertex = 0; vertex < vertexCount; vertex++) {
+			memcpy(destination, &model.vertices[vertex], PositionSize());
+			packColor(model.colors[vertex], destination + PositionSize());
+			destination += VertexSize();
+		}
+	}
+
+	[[nodiscard]] std::vector<std::byte>
+	Pack(const Model& model) const
+	{
+		std::vector<std::byte> data(VertexSize() * model.VertexCount());
+		Pack(model, data.data());
+		return data;
+	}
+
+	// The inverse of GL's normalized fixed-point conversion, c / 255
+	static GLubyte
+	Unorm8(GLfloat component)
+	{
+		return static_cast<GLubyte>(std::lround(std::clamp(component, 0.f, 1.f) * 255.f));
+	}
+
+private:
+	void
+	packColor(const ColorType3D& source, std::byte* destination) const
+	{
+		if (color == ColorEncoding::kFloat3) {
+			memcpy(destination, &source, sizeof(ColorType3D));
+			return;
+		}
+
+		const GLubyte rgba[4] = {Unorm8(source.r), Unorm8(source.g), Unorm8(source.b), 255};
+		memcpy(destination, rgba, sizeof(rgba));
+	}
+
+};
+
+
+#endif //HW2A_VERTEXFORMAT_HPP
@@ -0,0 +1,106 @@
+// Assignment 2a - Programming Interactive 2D Graphics with OpenGL
+// Work by Jacob Secunda
+//
+// Checks that the closed-form 2D affine composition GLmatrix uses (see
+// Matrix::ApplyTransforms) matches the generic chain of scale, rotation and
+// translation matrix products over random TRS parameters.
+//
+// Usage: HW2aMatrixComposeTest [iterations]
+
+#include <cmath>
+#include <cstdlib>
+#include <cstdio>
+#include <random>
+
+#include "core/Matrix.hpp"
+
+// The scale * rotation * translation product, multiplied out one factor at
+// a time like the generic ApplyTransforms() path (zero factors are skipped)
+static GLmatrix
+composeByProducts(const GLmatrix::Transforms& transforms)
+{
+	GLmatrix result;
+
+	if (transforms.scaleX != 0) {
+		GLmatrix scale;
+		scale[0] = transforms.scaleX;
+		result.MultiplyBy(scale);
+	}
+
+	if (transforms.scaleY != 0) {
+		GLmatrix scale;
+		scale[5] = transforms.scaleY;
+		result.MultiplyBy(scale);
+	}
+
+	if (transforms.rotation != 0) {
+		const float cosRads = ConstexprMath::Cos(transforms.rotation);
+		const float sinRads = ConstexprMath::Sin(transforms.rotation);
+
+		GLmatrix rotation;
+		rotation[0] = cosRads;
+		rotation[1] = -sinRads;
+		rotation[4] = sinRads;
+		rotation[5] = cosRads;
+		result.MultiplyBy(rotation);
+	}
+
+	if (transforms.translateX != 0) {
+		GLmatrix translation;
+		translation[12] = transforms.translateX;
+		result.MultiplyBy(translation);
+	}
+
+	if (transforms.translateY != 0) {
+		GLmatrix translation;
+		translation[13] = transforms.translateY;
+		result.MultiplyBy(translation);
+	}
+
+	return result;
+}
+
+int
+main(int argc, char* argv[])
+{
+	const int iterations = (argc > 1) ? std::max(1, atoi(argv[1])) : 100000;
+
+	std::mt19937 random(5607);
+	std::uniform_real_distribution<float> scales(-8.f, 8.f);
+	std::uniform_real_distribution<float> angles(-20.f, 20.f);
+	std::uniform_real_distribution<float> offsets(-100.f, 100.f);
+	std::uniform_int_distribution<int> zeroes(0, 15);
+
+	// Every so often a parameter is exactly zero, to cover the skipped factors
+	const auto maybeZero = [&](float value) { return (zeroes(random) == 0) ? 0.f : value; };
+
+	int failures = 0;
+	for (int iteration = 0; iteration < iterations; iteration++) {
+		GLmatrix::Transforms transforms;
+		transforms.scaleX = maybeZero(scales(random));
+		transforms.scaleY = maybeZero(scales(random));
+		transforms.rotation = maybeZero(angles(random));
+		transforms.translateX = maybeZero(offsets(random));
+		transforms.translateY = maybeZero(offsets(random));
+
+		GLmatrix closedForm;
+		closedForm.SetTransforms(transforms);
+		const GLmatrix expected = composeByProducts(transforms);
+
+		for (size_t index = 0; index < GLmatrix::Size; index++) {
+			// Allow for FMA contraction of the product chain
+			const float tolerance = 1e-6f * std::max(1.f, std::fabs(expected[index]));
+			if (std::fabs(closedForm[index] - expected[index]) <= tolerance)
+				continue;
+
+			if (failures++ < 10) {
+				printf("mismatch at [%zu]: closed form %.9g, products %.9g (S %g %g, R %g, T %g %g)\n",
+					index, closedForm[index], expected[index], transforms.scaleX, transforms.scaleY,
+					transforms.rotation, transforms.translateX, transforms.translateY);
+			}
+		}
+	}
+
+	printf("%d random transforms, %d mismatched elements\n", iterations, failures);
+	return (failures == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,72 @@
+// Assignment 2a - Programming Interactive 2D Graphics with OpenGL
+// Work by Jacob Secunda
+//
+// Checks at compile time that rotated and translated GLmatrix and
+// GLaffineMatrix constants, and a product of them, fold to the expected
+// coefficients. The program only exists so ctest reports the build.
+//
+// Usage: HW2aMatrixConstexprTest
+
+#include <cstdlib>
+#include <cstdio>
+#include <numbers>
+
+#include "core/AffineMatrix.hpp"
+#include "core/Matrix.hpp"
+
+static constexpr float kRotation = float(std::numbers::pi / 6);
+static constexpr float kCos = 0.866025404f;
+static constexpr float kSin = 0.5f;
+
+static constexpr bool
+near(float value, float expected)
+{
+	const float difference = value - expected;
+	return (difference < 0 ? -difference : difference) <= 1e-6f;
+}
+
+// Edited, then composed before being returned, see Matrix::invalidateTransforms()
+template<typename MatrixType>
+static constexpr MatrixType
+rotatedAndTranslated()
+{
+	MatrixType matrix;
+	matrix.ScaleXBy(1);
+	matrix.Rotate2DBy(kRotation);
+	matrix.TranslateXBy(0.5f);
+	matrix.TranslateYBy(-0.25f);
+	matrix.ApplyTransforms();
+	return matrix;
+}
+
+static constexpr GLmatrix kMatrix = rotatedAndTranslated<GLmatrix>();
+static_assert(near(kMatrix[0], 2 * kCos) && near(kMatrix[1], 2 * -kSin));
+static_assert(near(kMatrix[4], kSin) && near(kMatrix[5], kCos));
+static_assert(near(kMatrix[12], 0.5f) && near(kMatrix[13], -0.25f));
+static_assert(near(kMatrix[10], 1) && near(kMatrix[15], 1) && kMatrix[2] == 0 && kMatrix[14] == 0);
+
+static constexpr GLaffineMatrix kAffine = rotatedAndTranslated<GLaffineMatrix>();
+static_assert(near(kAffine[0], 2 * kCos) && near(kAffine[1], 2 * -kSin));
+static_assert(near(kAffine[2], kSin) && near(kAffine[3], kCos));
+static_assert(near(kAffine[4], 0.5f) && near(kAffine[5], -0.25f));
+
+// The lazy product folds too: rotating twice by pi/6 is rotating by pi/3
+static constexpr GLmatrix kRotation2 = [] {
+	GLmatrix rotation;
+	rotation.Rotate2DBy(kRotation);
+	rotation.ApplyTransforms();
+	return rotation;
+}();
+static constexpr GLmatrix kProduct = kRotation2 * kRotation2;
+static_assert(near(kProduct[0], 0.5f) && near(kProduct[1], -kCos));
+static_assert(near(kProduct[4], kCos) && near(kProduct[5], 0.5f));
+
+static constexpr GLaffineMatrix kAffineFromMatrix(kMatrix);
+static_assert(near(kAffineFromMatrix[0], kAffine[0]) && near(kAffineFromMatrix[5], kAffine[5]));
+
+int
+main()
+{
+	printf("constant matrices folded as expected\n");
+	return EXIT_SUCCESS;
+}
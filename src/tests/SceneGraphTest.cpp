@@ -0,0 +1,114 @@
+// Assignment 2a - Programming Interactive 2D Graphics with OpenGL
+// Work by Jacob Secunda
+//
+// Checks SceneGraph (see SceneGraph.hpp): how many world matrices Update()
+// recomputes after editing a root, a leaf, an inner node or nothing, and that
+// every world matrix equals local * parent world computed with Matrix
+// products.
+//
+// Usage: HW2aSceneGraphTest
+
+#include <cmath>
+#include <cstdlib>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "core/SceneGraph.hpp"
+
+static int sFailures = 0;
+
+static void
+expectCount(const char* edit, size_t count, size_t expected)
+{
+	if (count == expected)
+		return;
+
+	sFailures++;
+	printf("after editing %s, Update() recomputed %zu world matrices, expected %zu\n", edit, count, expected);
+}
+
+// Compares every node's world matrix with its local matrix times its parent's world matrix
+static void
+expectWorlds(const char* edit, const GLsceneGraph& graph)
+{
+	std::vector<GLmatrix> worlds(graph.NodeCount());
+	for (GLsceneGraph::NodeID node = 0; node < graph.NodeCount(); node++) {
+		const GLsceneGraph::NodeID parent = graph.Parent(node);
+		if (parent == GLsceneGraph::kNoParent)
+			worlds[node] = graph.Local(node);
+		else
+			worlds[node] = graph.Local(node) * worlds[parent];
+
+		const GLfloat* world = graph.WorldMatrix(node);
+		for (size_t index = 0; index < GLsceneGraph::kMatrixSize; index++) {
+			const float expected = worlds[node][index];
+			if (std::fabs(world[index] - expected) <= 1e-5f * std::max(1.f, std::fabs(expected)))
+				continue;
+
+			if (sFailures++ < 10) {
+				printf("after editing %s, node %u world [%zu] is %.9g, expected %.9g\n", edit, node, index,
+					world[index], expected);
+			}
+		}
+	}
+}
+
+int
+main()
+{
+	std::mt19937 random(5607);
+	std::uniform_real_distribution<float> values(-2.f, 2.f);
+
+	const auto randomize = [&](GLmatrix& matrix) {
+		matrix.SetTransforms({values(random), values(random), values(random), values(random), values(random)});
+	};
+
+	// 0 -> 1 -> 3
+	//   -> 2
+	// 4 -> 5
+	GLsceneGraph graph;
+	const GLsceneGraph::NodeID root = graph.AddNode();
+	const GLsceneGraph::NodeID inner = graph.AddNode(root);
+	const GLsceneGraph::NodeID sibling = graph.AddNode(root);
+	const GLsceneGraph::NodeID leaf = graph.AddNode(inner);
+	const GLsceneGraph::NodeID otherRoot = graph.AddNode();
+	graph.AddNode(otherRoot);
+
+	if (graph.AddNode(42) != GLsceneGraph::kNoParent) {
+		sFailures++;
+		printf("AddNode() accepted a parent that doesn't exist\n");
+	}
+
+	for (GLsceneGraph::NodeID node = 0; node < graph.NodeCount(); node++)
+		randomize(graph.EditLocal(node));
+
+	expectCount("every node", graph.Update(), graph.NodeCount());
+	expectWorlds("every node", graph);
+
+	expectCount("nothing", graph.Update(), 0);
+
+	randomize(graph.EditLocal(root));
+	expectCount("a root", graph.Update(), 4);
+	expectWorlds("a root", graph);
+
+	randomize(graph.EditLocal(leaf));
+	expectCount("a leaf", graph.Update(), 1);
+	expectWorlds("a leaf", graph);
+
+	randomize(graph.EditLocal(inner));
+	expectCount("an inner node", graph.Update(), 2);
+	expectWorlds("an inner node", graph);
+
+	// A parent and its child edited together are each recomputed once
+	randomize(graph.EditLocal(sibling));
+	randomize(graph.EditLocal(otherRoot));
+	randomize(graph.EditLocal(leaf));
+	expectCount("two subtrees", graph.Update(), 4);
+	expectWorlds("two subtrees", graph);
+
+	expectCount("nothing", graph.Update(), 0);
+
+	printf("%zu nodes, %d failures\n", graph.NodeCount(), sFailures);
+	return (sFailures == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,153 @@
+// Assignment 2a - Programming Interactive 2D Graphics with OpenGL
+// Work by Jacob Secunda
+//
+// Checks the bulk transforms of TransformPoints.hpp, in both the array of
+// structs and the structure of arrays form, against applying the Matrix to
+// one (x, y, z, 1) row at a time through its element accessors. Every length
+// up to a few SIMD widths is tried, so the scalar tails after the SSE2 and
+// AVX loops are covered, both into a separate output and in place.
+//
+// Usage: HW2aTransformPointsTest
+
+#include <cmath>
+#include <cstdlib>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "core/TransformPoints.hpp"
+
+static constexpr size_t kMaxLength = 37;
+
+static int sFailures = 0;
+
+// The row vector (x, y, z, 1) times 'matrix', the translation being its last row
+template<typename T>
+static Vector3D<T>
+applyByElements(const Matrix4D<T>& matrix, T x, T y, T z)
+{
+	const T row[4] = {x, y, z, 1};
+
+	T result[3] = {};
+	for (size_t column = 0; column < 3; column++) {
+		for (size_t k = 0; k < 4; k++)
+			result[column] += row[k] * matrix(k, column);
+	}
+
+	return {result[0], result[1], result[2]};
+}
+
+template<typename T>
+static void
+check(const char* test, size_t length, size_t index, T value, T expected)
+{
+	// Allow for a different summation order or FMA contraction
+	const T tolerance = T(1e-5) * std::max<T>(1, std::fabs(expected));
+	if (std::fabs(value - expected) <= tolerance)
+		return;
+
+	if (sFailures++ < 10)
+		printf("%s, length %zu, element %zu: %.9g, expected %.9g\n", test, length, index, double(value), double(expected));
+}
+
+template<typename T>
+static void
+testLength(const Matrix4D<T>& matrix, size_t length, std::mt19937& random)
+{
+	std::uniform_real_distribution<T> values(-10, 10);
+
+	std::vector<Point2D<T>> points(length);
+	std::vector<T> xs(length), ys(length);
+	std::vector<Vector3D<T>> vectors(length);
+	for (size_t index = 0; index < length; index++) {
+		points[index] = {values(random), values(random)};
+		xs[index] = points[index].x;
+		ys[index] = points[index].y;
+		vectors[index] = {values(random), values(random), values(random)};
+	}
+
+	// Array of structs, into a separate output and in place
+	std::vector<Point2D<T>> outPoints(length);
+	if (TransformPoints(matrix, points, outPoints) != length)
+		sFailures++;
+
+	std::vector<Point2D<T>> inPlacePoints = points;
+	TransformPoints(matrix, inPlacePoints, inPlacePoints);
+
+	// Structure of arrays, into a separate output and in place
+	std::vector<T> outXs(length), outYs(length);
+	if (TransformPoints<T>(matrix, xs, ys, outXs, outYs) != length)
+		sFailures++;
+
+	std::vector<T> inPlaceXs = xs, inPlaceYs = ys;
+	TransformPoints<T>(matrix, inPlaceXs, inPlaceYs, inPlaceXs, inPlaceYs);
+
+	std::vector<Vector3D<T>> outVectors(length);
+	if (TransformVectors(matrix, vectors, outVectors) != length)
+		sFailures++;
+
+	for (size_t index = 0; index < length; index++) {
+		const Vector3D<T> point = applyByElements<T>(matrix, points[index].x, points[index].y, 0);
+		check("points", length, index, outPoints[index].x, point.dx);
+		check("points", length, index, outPoints[index].y, point.dy);
+		check("points in place", length, index, inPlacePoints[index].x, point.dx);
+		check("points in place", length, index, inPlacePoints[index].y, point.dy);
+		check("arrays", length, index, outXs[index], point.dx);
+		check("arrays", length, index, outYs[index], point.dy);
+		check("arrays in place", length, index, inPlaceXs[index], point.dx);
+		check("arrays in place", length, index, inPlaceYs[index], point.dy);
+
+		const Vector3D<T> vector = applyByElements<T>(matrix, vectors[index].dx, vectors[index].dy, vectors[index].dz);
+		check("vectors", length, index, outVectors[index].dx, vector.dx);
+		check("vectors", length, index, outVectors[index].dy, vector.dy);
+		check("vectors", length, index, outVectors[index].dz, vector.dz);
+	}
+
+	// A shorter output limits the count
+	if (length > 0 && TransformPoints(matrix, points, std::span(outPoints).first(length - 1)) != length - 1)
+		sFailures++;
+}
+
+template<typename T>
+static void
+testAllLengths(std::mt19937& random)
+{
+	std::uniform_real_distribution<T> values(-2, 2);
+
+	for (int matrixIndex = 0; matrixIndex < 8; matrixIndex++) {
+		Matrix4D<T> matrix;
+		matrix.SetTransforms({values(random), values(random), values(random), values(random), values(random)});
+
+		// Fill the z row and column too, which only TransformVectors reads
+		matrix[2] = values(random);
+		matrix[6] = values(random);
+		matrix[8] = values(random);
+		matrix[9] = values(random);
+		matrix[10] = values(random);
+		matrix[14] = values(random);
+
+		for (size_t length = 0; length <= kMaxLength; length++)
+			testLength(matrix, length, random);
+	}
+}
+
+int
+main()
+{
+	std::mt19937 random(5607);
+
+	// float takes the SIMD paths where the build has them, double the scalar loops
+	testAllLengths<float>(random);
+	testAllLengths<double>(random);
+
+#if HW2A_HAVE_AVX
+	const char* kernels = "AVX";
+#elif HW2A_HAVE_SSE2
+	const char* kernels = "SSE2";
+#else
+	const char* kernels = "scalar";
+#endif
+
+	printf("lengths 0 to %zu with %s kernels, %d mismatches\n", kMaxLength, kernels, sFailures);
+	return (sFailures == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
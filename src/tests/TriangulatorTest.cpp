@@ -0,0 +1,259 @@
+// Assignment 2a - Programming Interactive 2D Graphics with OpenGL
+// Work by Jacob Secunda
+//
+// Checks PolygonTriangulator and TriangulatePolygons (see Triangulator.hpp)
+// on concave outlines (combs, staircases, collinear runs, random stars) and
+// on stars with holes, in either winding. Every triangulation must cover the
+// polygon's area with n + 2h - 2 counter-clockwise triangles, n being the
+// point count and h the hole count. The batch entry point must give the same
+// triangles as triangulating each polygon alone.
+//
+// Usage: HW2aTriangulatorTest
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstdio>
+#include <numbers>
+#include <random>
+#include <span>
+#include <vector>
+
+#include "core/Triangulator.hpp"
+
+using Polygon = Polygon2D<float>;
+using Ring = std::vector<Point2Df>;
+
+static int sFailures = 0;
+
+static void
+fail(const char* test, size_t polygon, const char* message)
+{
+	if (sFailures++ < 10)
+		printf("%s, polygon %zu: %s\n", test, polygon, message);
+}
+
+static double
+ringArea(const Ring& ring)
+{
+	double area = 0;
+	for (size_t point = 0; point < ring.size(); point++) {
+		const Point2Df& current = ring[point];
+		const Point2Df& next = ring[(point + 1) % ring.size()];
+		area += (double(current.x) * double(next.y)) - (double(next.x) * double(current.y));
+	}
+
+	return std::fabs(area) / 2;
+}
+
+// Checks one polygon's triangles: index range, winding, count and total area
+static void
+checkTriangles(const char* test, size_t index, const Polygon& polygon, const std::vector<uint32_t>& indices)
+{
+	std::vector<Point2Df> points(polygon.outline);
+	for (const Ring& hole : polygon.holes)
+		points.insert(points.end(), hole.begin(), hole.end());
+
+	const size_t expectedCount = points.size() + (2 * polygon.holes.size()) - 2;
+	if (indices.size() != 3 * expectedCount) {
+		char message[96];
+		snprintf(message, sizeof(message), "%zu triangles, expected %zu", indices.size() / 3, expectedCount);
+		fail(test, index, message);
+		return;
+	}
+
+	double expectedArea = ringArea(polygon.outline);
+	for (const Ring& hole : polygon.holes)
+		expectedArea -= ringArea(hole);
+
+	double area = 0;
+	for (size_t triangle = 0; triangle < indices.size(); triangle += 3) {
+		if (std::max({indices[triangle], indices[triangle + 1], indices[triangle + 2]}) >= points.size()) {
+			fail(test, index, "index out of range");
+			return;
+		}
+
+		const Point2Df& a = points[indices[triangle]];
+		const Point2Df& b = points[indices[triangle + 1]];
+		const Point2Df& c = points[indices[triangle + 2]];
+		const double twiceArea = ((double(b.x) - a.x) * (double(c.y) - a.y)) - ((double(b.y) - a.y) * (double(c.x) - a.x));
+
+		// Collinear runs give zero-area triangles, never clockwise ones
+		if (twiceArea < -1e-9) {
+			fail(test, index, "clockwise triangle");
+			return;
+		}
+
+		area += twiceArea / 2;
+	}
+
+	if (std::fabs(area - expectedArea) > 1e-6 * std::max(1.0, expectedArea)) {
+		char message[96];
+		snprintf(message, sizeof(message), "triangles cover %.9g, expected %.9g", area, expectedArea);
+		fail(test, index, message);
+	}
+}
+
+static Ring
+reversed(Ring ring)
+{
+	std::reverse(ring.begin(), ring.end());
+	return ring;
+}
+
+// Teeth pointing up or down from a bar, so both split and merge vertices occur
+static Ring
+comb(int teeth, bool up)
+{
+	Ring ring;
+	const float sign = up ? 1.f : -1.f;
+	ring.push_back({0, 0});
+	for (int tooth = 0; tooth < teeth; tooth++) {
+		const float x = float(2 * tooth);
+		ring.push_back({x, sign * float(3 + (tooth % 3))});
+		ring.push_back({x + 1, sign * float(3 + (tooth % 3))});
+		ring.push_back({x + 1, sign * 1.f});
+		ring.push_back({x + 2, sign * 1.f});
+	}
+	ring.back() = {float(2 * teeth), -sign * 1.f};
+	ring.push_back({0, -sign * 1.f});
+
+	return up ? ring : reversed(ring);
+}
+
+// Steps of equal height, with an extra point in the middle of every tread
+static Ring
+staircase(int steps)
+{
+	Ring ring = {{0, 0}, {float(2 * steps), 0}};
+	for (int step = steps; step > 0; step--) {
+		ring.push_back({float(2 * step), float(steps - step + 1)});
+		ring.push_back({float(2 * step - 1), float(steps - step + 1)});
+		ring.push_back({float(2 * step - 2), float(steps - step + 1)});
+	}
+
+	return ring;
+}
+
+// A square with several points along each side
+static Ring
+collinearSquare(int pointsPerSide)
+{
+	Ring ring;
+	for (int point = 0; point < pointsPerSide; point++)
+		ring.push_back({float(point), 0});
+	for (int point = 0; point < pointsPerSide; point++)
+		ring.push_back({float(pointsPerSide), float(point)});
+	for (int point = 0; point < pointsPerSide; point++)
+		ring.push_back({float(pointsPerSide - point), float(pointsPerSide)});
+	for (int point = 0; point < pointsPerSide; point++)
+		ring.push_back({0, float(pointsPerSide - point)});
+
+	return ring;
+}
+
+// Points at increasing angles and random radii in [minRadius, 1]
+static Ring
+star(std::mt19937& random, int pointCount, float minRadius)
+{
+	std::uniform_real_distribution<float> radii(minRadius, 1.f);
+	Ring ring;
+	for (int point = 0; point < pointCount; point++) {
+		const float angle = 2 * std::numbers::pi_v<float> * float(point) / float(pointCount);
+		const float radius = radii(random);
+		ring.push_back({radius * std::cos(angle), radius * std::sin(angle)});
+	}
+
+	return ring;
+}
+
+// A star around a grid of small squares and diamonds, some of them sharing
+// rows with each other so the sweep meets equal y coordinates
+static Polygon
+starWithHoles(std::mt19937& random, int pointCount, int grid)
+{
+	std::uniform_int_distribution<int> coin(0, 1);
+
+	Polygon polygon;
+	polygon.outline = star(random, pointCount, 0.6f);
+	if (coin(random) == 0)
+		polygon.outline = reversed(polygon.outline);
+
+	const float cell = 0.7f / float(grid);
+	const float size = 0.3f * cell;
+	for (int row = 0; row < grid; row++) {
+		for (int column = 0; column < grid; column++) {
+			if (coin(random) == 0)
+				continue;
+
+			const float x = -0.35f + (cell * (float(column) + 0.5f));
+			const float y = -0.35f + (cell * (float(row) + 0.5f));
+			Ring hole;
+			if (coin(random) == 0)
+				hole = {{x - size, y - size}, {x + size, y - size}, {x + size, y + size}, {x - size, y + size}};
+			else
+				hole = {{x, y - size}, {x + size, y}, {x, y + size}, {x - size, y}};
+
+			polygon.holes.push_back(coin(random) == 0 ? hole : reversed(hole));
+		}
+	}
+
+	return polygon;
+}
+
+int
+main()
+{
+	std::mt19937 random(5607);
+	std::uniform_int_distribution<int> pointCounts(3, 200);
+
+	std::vector<Polygon> polygons;
+	for (int teeth = 1; teeth <= 6; teeth++) {
+		polygons.push_back({comb(teeth, true), {}});
+		polygons.push_back({comb(teeth, false), {}});
+		polygons.push_back({staircase(teeth), {}});
+		polygons.push_back({reversed(staircase(teeth)), {}});
+		polygons.push_back({collinearSquare(teeth + 1), {}});
+	}
+	for (int polygon = 0; polygon < 100; polygon++) {
+		const Ring outline = star(random, pointCounts(random), 0.2f);
+		polygons.push_back({(polygon % 2 == 0) ? outline : reversed(outline), {}});
+	}
+	for (int polygon = 0; polygon < 100; polygon++)
+		polygons.push_back(starWithHoles(random, pointCounts(random), 1 + (polygon % 5)));
+
+	// One polygon at a time, reusing a triangulator as PolygonShape does
+	PolygonTriangulator<float> triangulator;
+	std::vector<std::vector<uint32_t>> singles(polygons.size());
+	for (size_t polygon = 0; polygon < polygons.size(); polygon++) {
+		if (!triangulator.Triangulate(polygons[polygon], singles[polygon]))
+			fail("Triangulate", polygon, "refused");
+		else
+			checkTriangles("Triangulate", polygon, polygons[polygon], singles[polygon]);
+	}
+
+	// Too few points: refused, appending nothing
+	std::vector<uint32_t> indices = {7};
+	if (triangulator.Triangulate(Polygon{{{0, 0}, {1, 0}}, {}}, indices) || indices.size() != 1)
+		fail("Triangulate", polygons.size(), "accepted a two-point outline");
+
+	// The batch entry point on a few thread counts, including one thread per hardware thread
+	for (unsigned threadCount : {1u, 4u, 0u}) {
+		const std::vector<std::vector<uint32_t>> batch = TriangulatePolygons(std::span<const Polygon>(polygons), threadCount);
+		if (batch.size() != polygons.size()) {
+			fail("TriangulatePolygons", batch.size(), "wrong result count");
+			continue;
+		}
+
+		for (size_t polygon = 0; polygon < polygons.size(); polygon++) {
+			if (batch[polygon] != singles[polygon])
+				fail("TriangulatePolygons", polygon, "differs from Triangulate");
+		}
+	}
+
+	if (!TriangulatePolygons(std::span<const Polygon>()).empty())
+		fail("TriangulatePolygons", 0, "returned results for no polygons");
+
+	printf("%zu polygons, %d failures\n", polygons.size(), sFailures);
+	return (sFailures == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,168 @@
+// Assignment 2a - Programming Interactive 2D Graphics with OpenGL
+// Work by Jacob Secunda
+//
+// Checks the bulk operations of Vector3DArray (see Vector3DArray.hpp):
+// NormalizeAll() at every NormalizeAccuracy against its documented bound,
+// with kExact also matching Vector3D::NormalizeSelf(), and Lengths, Dot,
+// Cross and Scale against the same Vector3D operation one vector at a time.
+// Array sizes run past a few register widths so the scalar tails are covered.
+//
+// Usage: HW2aVector3DArrayTest
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstdio>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "core/Vector3DArray.hpp"
+
+static constexpr size_t kMaxSize = 41;
+
+static int sFailures = 0;
+
+static void
+check(const char* test, size_t size, size_t index, double value, double expected, double tolerance)
+{
+	if (std::fabs(value - expected) <= tolerance)
+		return;
+
+	if (sFailures++ < 10) {
+		printf("%s, size %zu, element %zu: %.9g, expected %.9g (tolerance %g)\n", test, size, index, value,
+			expected, tolerance);
+	}
+}
+
+// Rounding of a few float operations on values of 'magnitude'
+static double
+floatTolerance(double magnitude)
+{
+	return 4 * double(std::numeric_limits<float>::epsilon()) * std::max(1.0, magnitude);
+}
+
+static void
+testNormalize(const std::vector<Vector3Df>& vectors)
+{
+	const struct {
+		NormalizeAccuracy accuracy;
+		const char* name;
+		double bound;
+	} accuracies[] = {
+		{NormalizeAccuracy::kExact, "kExact", std::ldexp(1.0, -22)},
+		{NormalizeAccuracy::kFast, "kFast", std::ldexp(1.0, -21)},
+		{NormalizeAccuracy::kApproximate, "kApproximate", std::ldexp(1.0, -11)}
+	};
+
+	for (const auto& accuracy : accuracies) {
+		Vector3DArrayf array(vectors);
+		array.NormalizeAll(accuracy.accuracy);
+
+		for (size_t index = 0; index < vectors.size(); index++) {
+			const Vector3Df& source = vectors[index];
+			const Vector3Df result = array.Get(index);
+
+			// Zero-length vectors are left alone
+			if (source.dx == 0 && source.dy == 0 && source.dz == 0) {
+				check(accuracy.name, vectors.size(), index, result.Length(), 0, 0);
+				continue;
+			}
+
+			const Vector3D<double> exact(source.dx, source.dy, source.dz);
+			const Vector3D<double> unit = exact.Normalize();
+			check(accuracy.name, vectors.size(), index, result.dx, unit.dx, accuracy.bound);
+			check(accuracy.name, vectors.size(), index, result.dy, unit.dy, accuracy.bound);
+			check(accuracy.name, vectors.size(), index, result.dz, unit.dz, accuracy.bound);
+
+			if (accuracy.accuracy == NormalizeAccuracy::kExact) {
+				const Vector3Df scalar = source.Normalize();
+				check("kExact vs NormalizeSelf", vectors.size(), index, result.dx, scalar.dx, floatTolerance(0));
+				check("kExact vs NormalizeSelf", vectors.size(), index, result.dy, scalar.dy, floatTolerance(0));
+				check("kExact vs NormalizeSelf", vectors.size(), index, result.dz, scalar.dz, floatTolerance(0));
+			}
+		}
+	}
+}
+
+static void
+testProducts(const std::vector<Vector3Df>& vectors, const std::vector<Vector3Df>& others, const Vector3Df& single)
+{
+	const size_t size = vectors.size();
+	const Vector3DArrayf array(vectors);
+	const Vector3DArrayf otherArray(others);
+
+	std::vector<float> lengths(size), dots(size), pairDots(size);
+	array.Lengths(lengths);
+	array.Dot(single, dots);
+	array.Dot(otherArray, pairDots);
+
+	Vector3DArrayf crosses, pairCrosses;
+	array.Cross(single, crosses);
+	array.Cross(otherArray, pairCrosses);
+
+	Vector3DArrayf scaled(vectors);
+	scaled.Scale(-2.5f);
+
+	for (size_t index = 0; index < size; index++) {
+		const Vector3Df& vector = vectors[index];
+		const double scale = vector.Length() * std::max(single.Length(), others[index].Length());
+
+		check("Lengths", size, index, lengths[index], vector.Length(), floatTolerance(vector.Length()));
+		check("Dot", size, index, dots[index], vector.DotProduct(single), floatTolerance(scale));
+		check("pairwise Dot", size, index, pairDots[index], vector.DotProduct(others[index]), floatTolerance(scale));
+
+		const Vector3Df cross = vector.CrossProduct(single);
+		const Vector3Df pairCross = vector.CrossProduct(others[index]);
+		check("Cross dx", size, index, crosses.Get(index).dx, cross.dx, floatTolerance(scale));
+		check("Cross dy", size, index, crosses.Get(index).dy, cross.dy, floatTolerance(scale));
+		check("Cross dz", size, index, crosses.Get(index).dz, cross.dz, floatTolerance(scale));
+		check("pairwise Cross dx", size, index, pairCrosses.Get(index).dx, pairCross.dx, floatTolerance(scale));
+		check("pairwise Cross dy", size, index, pairCrosses.Get(index).dy, pairCross.dy, floatTolerance(scale));
+		check("pairwise Cross dz", size, index, pairCrosses.Get(index).dz, pairCross.dz, floatTolerance(scale));
+
+		const Vector3Df scaledVector = vector * -2.5f;
+		check("Scale", size, index, scaled.Get(index).dx, scaledVector.dx, 0);
+		check("Scale", size, index, scaled.Get(index).dy, scaledVector.dy, 0);
+		check("Scale", size, index, scaled.Get(index).dz, scaledVector.dz, 0);
+	}
+
+	if (crosses.Size() != size || pairCrosses.Size() != size) {
+		sFailures++;
+		printf("Cross resized its output to %zu and %zu, expected %zu\n", crosses.Size(), pairCrosses.Size(), size);
+	}
+}
+
+int
+main()
+{
+	std::mt19937 random(5607);
+	std::uniform_real_distribution<float> values(-100.f, 100.f);
+	std::uniform_int_distribution<int> exponents(-30, 30);
+	std::uniform_int_distribution<int> zeroes(0, 9);
+
+	// Components over a wide range of magnitudes, and now and then a zero vector
+	const auto randomVector = [&]() {
+		if (zeroes(random) == 0)
+			return Vector3Df(0, 0, 0);
+
+		const float scale = std::ldexp(1.f, exponents(random));
+		return Vector3Df(values(random) * scale, values(random) * scale, values(random) * scale);
+	};
+
+	for (int repetition = 0; repetition < 50; repetition++) {
+		for (size_t size = 0; size <= kMaxSize; size++) {
+			std::vector<Vector3Df> vectors(size), others(size);
+			for (size_t index = 0; index < size; index++) {
+				vectors[index] = randomVector();
+				others[index] = Vector3Df(values(random), values(random), values(random));
+			}
+
+			testNormalize(vectors);
+			testProducts(vectors, others, Vector3Df(values(random), values(random), values(random)));
+		}
+	}
+
+	printf("sizes 0 to %zu, %d failures\n", kMaxSize, sFailures);
+	return (sFailures == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,88 @@
+// Assignment 2a - Programming Interactive 2D Graphics with OpenGL
+// Work by Jacob Secunda
+#ifndef HW2A_INSTRUCTIONCOUNTER_HPP
+#define HW2A_INSTRUCTIONCOUNTER_HPP
+
+#include <chrono>
+#include <cstdint>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// Counts user-space instructions retired by this thread between Start() and
+// Stop(), through perf_event_open on Linux. Where that isn't available (other
+// platforms, or perf_event_paranoid forbids it) Available() is false and only
+// the elapsed time is measured.
+class InstructionCounter {
+public:
+	InstructionCounter()
+	{
+#if defined(__linux__)
+		perf_event_attr attributes{};
+		attributes.type = PERF_TYPE_HARDWARE;
+		attributes.size = sizeof(attributes);
+		attributes.config = PERF_COUNT_HW_INSTRUCTIONS;
+		attributes.disabled = 1;
+		attributes.exclude_kernel = 1;
+		attributes.exclude_hv = 1;
+
+		fDescriptor = static_cast<int>(syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0));
+#endif
+	}
+
+	~InstructionCounter()
+	{
+#if defined(__linux__)
+		if (fDescriptor >= 0)
+			close(fDescriptor);
+#endif
+	}
+
+	InstructionCounter(const InstructionCounter&) = delete;
+	InstructionCounter& operator=(const InstructionCounter&) = delete;
+
+	[[nodiscard]] bool Available() const { return fDescriptor >= 0; }
+
+	void
+	Start()
+	{
+#if defined(__linux__)
+		if (fDescriptor >= 0) {
+			ioctl(fDescriptor, PERF_EVENT_IOC_RESET, 0);
+			ioctl(fDescriptor, PERF_EVENT_IOC_ENABLE, 0);
+		}
+#endif
+		fStart = std::chrono::steady_clock::now();
+	}
+
+	void
+	Stop()
+	{
+		fSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - fStart).count();
+
+		fInstructions = 0;
+#if defined(__linux__)
+		if (fDescriptor >= 0) {
+			ioctl(fDescriptor, PERF_EVENT_IOC_DISABLE, 0);
+			if (read(fDescriptor, &fInstructions, sizeof(fInstructions)) != sizeof(fInstructions))
+				fInstructions = 0;
+		}
+#endif
+	}
+
+	[[nodiscard]] uint64_t Instructions() const { return fInstructions; }
+	[[nodiscard]] double Seconds() const { return fSeconds; }
+
+private:
+	int fDescriptor = -1;
+	std::chrono::steady_clock::time_point fStart;
+	uint64_t fInstructions = 0;
+	double fSeconds = 0;
+};
+
+
+#endif //HW2A_INSTRUCTIONCOUNTER_HPP
@@ -0,0 +1,172 @@
+// Assignment 2a - Programming Interactive 2D Graphics with OpenGL
+// Work by Jacob Secunda
+//
+// Compares GLmatrix::AffineInverse() and GLmatrix::Inverse() (see Matrix.hpp)
+// against a naive Gauss-Jordan elimination on the augmented 4x8 matrix, over
+// random TRS transforms. Reports instructions (where perf counters are
+// available), nanoseconds per inverse, and the largest error of M * M^-1
+// against the identity.
+//
+// Usage: HW2aMatrixInverseBenchmark [inverses]
+
+#include <cmath>
+#include <cstdlib>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "core/Matrix.hpp"
+#include "tools/InstructionCounter.hpp"
+
+// Textbook Gauss-Jordan with partial pivoting on [M | I], row by row
+[[gnu::noinline]] static bool
+gaussJordanInverse(const GLmatrix& matrix, GLmatrix& inverse)
+{
+	float augmented[4][8];
+	for (size_t row = 0; row < 4; row++) {
+		for (size_t column = 0; column < 4; column++) {
+			augmented[row][column] = matrix(row, column);
+			augmented[row][column + 4] = (row == column) ? 1.f : 0.f;
+		}
+	}
+
+	for (size_t pivot = 0; pivot < 4; pivot++) {
+		size_t bestRow = pivot;
+		for (size_t row = pivot + 1; row < 4; row++) {
+			if (std::fabs(augmented[row][pivot]) > std::fabs(augmented[bestRow][pivot]))
+				bestRow = row;
+		}
+
+		if (augmented[bestRow][pivot] == 0)
+			return false;
+
+		for (size_t column = 0; column < 8; column++)
+			std::swap(augmented[pivot][column], augmented[bestRow][column]);
+
+		const float divisor = augmented[pivot][pivot];
+		for (size_t column = 0; column < 8; column++)
+			augmented[pivot][column] /= divisor;
+
+		for (size_t row = 0; row < 4; row++) {
+			if (row == pivot)
+				continue;
+
+			const float factor = augmented[row][pivot];
+			for (size_t column = 0; column < 8; column++)
+				augmented[row][column] -= factor * augmented[pivot][column];
+		}
+	}
+
+	for (size_t row = 0; row < 4; row++) {
+		for (size_t column = 0; column < 4; column++)
+			inverse(row, column) = augmented[row][column + 4];
+	}
+
+	return true;
+}
+
+[[gnu::noinline]] static bool
+affineInverse(const GLmatrix& matrix, GLmatrix& inverse)
+{
+	const std::optional<GLmatrix> result = matrix.AffineInverse();
+	if (!result)
+		return false;
+
+	inverse = *result;
+	return true;
+}
+
+[[gnu::noinline]] static bool
+generalInverse(const GLmatrix& matrix, GLmatrix& inverse)
+{
+	const std::optional<GLmatrix> result = matrix.Inverse();
+	if (!result)
+		return false;
+
+	inverse = *result;
+	return true;
+}
+
+// Largest |(M * M^-1)(row, column) - I(row, column)|
+static float
+identityError(const GLmatrix& matrix, const GLmatrix& inverse)
+{
+	const GLmatrix product = matrix * inverse;
+
+	float error = 0;
+	for (size_t row = 0; row < 4; row++) {
+		for (size_t column = 0; column < 4; column++)
+			error = std::max(error, std::fabs(product(row, column) - ((row == column) ? 1.f : 0.f)));
+	}
+
+	return error;
+}
+
+static constexpr int kRepetitions = 5;
+
+// Inverts every matrix in the pool 'inverses' times over, best of 'kRepetitions' passes
+template<typename Invert>
+static void
+run(const char* name, const std::vector<GLmatrix>& pool, size_t inverses, Invert invert)
+{
+	GLmatrix inverse;
+	float sink = 0;
+
+	InstructionCounter counter;
+	double bestInstructions = 0;
+	double bestSeconds = 0;
+	for (int repetition = 0; repetition < kRepetitions; repetition++) {
+		counter.Start();
+		for (size_t index = 0; index < inverses; index++) {
+			invert(pool[index % pool.size()], inverse);
+			sink += inverse[0];
+		}
+		counter.Stop();
+
+		if (repetition == 0 || double(counter.Instructions()) < bestInstructions)
+			bestInstructions = double(counter.Instructions());
+		if (repetition == 0 || counter.Seconds() < bestSeconds)
+			bestSeconds = counter.Seconds();
+	}
+
+	float maxError = 0;
+	for (const GLmatrix& matrix : pool) {
+		if (invert(matrix, inverse))
+			maxError = std::max(maxError, identityError(matrix, inverse));
+	}
+
+	const double nanoseconds = bestSeconds * 1e9 / double(inverses);
+	if (counter.Available()) {
+		printf("%-14s %14.1f %10.2f %12.3g\n", name, bestInstructions / double(inverses), nanoseconds,
+			double(maxError));
+	} else {
+		printf("%-14s %14s %10.2f %12.3g\n", name, "n/a", nanoseconds, double(maxError));
+	}
+
+	// Keep the inverses from being optimized away
+	volatile float keep = sink;
+	(void)keep;
+}
+
+int
+main(int argc, char* argv[])
+{
+	const size_t inverses = (argc > 1) ? std::max(1L, atol(argv[1])) : 1000000;
+
+	std::mt19937 random(5607);
+	std::uniform_real_distribution<float> scales(0.1f, 4.f);
+	std::uniform_real_distribution<float> angles(-4.f, 4.f);
+	std::uniform_real_distribution<float> offsets(-2.f, 2.f);
+
+	std::vector<GLmatrix> pool(1024);
+	for (GLmatrix& matrix : pool)
+		matrix.SetTransforms({scales(random), scales(random), angles(random), offsets(random), offsets(random)});
+
+	printf("%zu inverses of random TRS transforms, best of %d\n", inverses, kRepetitions);
+	printf("%-14s %14s %10s %12s\n", "inverse", "instructions", "ns", "max error");
+	run("gauss-jordan", pool, inverses, gaussJordanInverse);
+	run("Inverse", pool, inverses, generalInverse);
+	run("AffineInverse", pool, inverses, affineInverse);
+
+	return EXIT_SUCCESS;
+}
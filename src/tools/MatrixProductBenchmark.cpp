@@ -0,0 +1,123 @@
+// Assignment 2a - Programming Interactive 2D Graphics with OpenGL
+// Work by Jacob Secunda
+//
+// Compares 3- and 5-factor GLmatrix product chains evaluated lazily through
+// MatrixProduct (see MatrixProduct.hpp) against eager evaluation, where every
+// pairwise product is materialized as its own Matrix. Both use the same
+// multiply kernel, so the difference is the intermediate construction and
+// copies. Reports instructions (where perf counters are available) and
+// nanoseconds per chain.
+//
+// Usage: HW2aMatrixProductBenchmark [chains]
+
+#include <cstdlib>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "core/Matrix.hpp"
+#include "tools/InstructionCounter.hpp"
+
+// One pairwise product the way operator* worked before it became lazy
+[[gnu::noinline]] static GLmatrix
+eagerProduct(const GLmatrix& left, const GLmatrix& right)
+{
+	GLmatrix product(left);
+	product.MultiplyBy(right);
+	return product;
+}
+
+template<size_t Factors>
+[[gnu::noinline]] static void
+lazyChain(const GLmatrix* factors, GLmatrix& result)
+{
+	if constexpr (Factors == 3)
+		result = factors[0] * factors[1] * factors[2];
+	else
+		result = factors[0] * factors[1] * factors[2] * factors[3] * factors[4];
+}
+
+template<size_t Factors>
+[[gnu::noinline]] static void
+eagerChain(const GLmatrix* factors, GLmatrix& result)
+{
+	if constexpr (Factors == 3) {
+		result = eagerProduct(eagerProduct(factors[0], factors[1]), factors[2]);
+	} else {
+		result = eagerProduct(eagerProduct(eagerProduct(eagerProduct(factors[0], factors[1]), factors[2]),
+			factors[3]), factors[4]);
+	}
+}
+
+// Runs 'chain' over windows of 'Factors' matrices from the pool, best of
+// 'kRepetitions' passes, and prints one row
+static constexpr int kRepetitions = 5;
+
+template<size_t Factors, typename Chain>
+static double
+run(const char* name, const std::vector<GLmatrix>& pool, size_t chains, Chain chain)
+{
+	GLmatrix result;
+	float sink = 0;
+
+	InstructionCounter counter;
+	double bestInstructions = 0;
+	double bestSeconds = 0;
+	for (int repetition = 0; repetition < kRepetitions; repetition++) {
+		counter.Start();
+		for (size_t index = 0; index < chains; index++) {
+			chain(&pool[index % (pool.size() - Factors)], result);
+			sink += result[0];
+		}
+		counter.Stop();
+
+		if (repetition == 0 || double(counter.Instructions()) < bestInstructions)
+			bestInstructions = double(counter.Instructions());
+		if (repetition == 0 || counter.Seconds() < bestSeconds)
+			bestSeconds = counter.Seconds();
+	}
+
+	const double nanoseconds = bestSeconds * 1e9 / double(chains);
+	if (counter.Available())
+		printf("%-8s %8zu %14.1f %10.2f\n", name, Factors, bestInstructions / double(chains), nanoseconds);
+	else
+		printf("%-8s %8zu %14s %10.2f\n", name, Factors, "n/a", nanoseconds);
+
+	// Keep the products from being optimized away
+	volatile float keep = sink;
+	(void)keep;
+	return counter.Available() ? bestInstructions : bestSeconds;
+}
+
+template<size_t Factors>
+static void
+compare(const std::vector<GLmatrix>& pool, size_t chains)
+{
+	const double eager = run<Factors>("eager", pool, chains, eagerChain<Factors>);
+	const double lazy = run<Factors>("lazy", pool, chains, lazyChain<Factors>);
+	printf("%-8s %8zu %14.2fx\n", "ratio", Factors, eager / lazy);
+}
+
+int
+main(int argc, char* argv[])
+{
+	const size_t chains = (argc > 1) ? std::max(1L, atol(argv[1])) : 1000000;
+
+	// Random TRS matrices, so no product is a constant the compiler can fold
+	std::mt19937 random(5607);
+	std::uniform_real_distribution<float> values(-2.f, 2.f);
+
+	std::vector<GLmatrix> pool(1024);
+	for (GLmatrix& matrix : pool) {
+		matrix.SetTransforms({values(random), values(random), values(random), values(random), values(random)});
+		matrix[2] = values(random);
+		matrix[15] = 1;
+	}
+
+	printf("%zu chains of each length, best of %d\n", chains, kRepetitions);
+	printf("%-8s %8s %14s %10s\n", "chain", "factors", "instructions", "ns");
+	compare<3>(pool, chains);
+	compare<5>(pool, chains);
+
+	return EXIT_SUCCESS;
+}
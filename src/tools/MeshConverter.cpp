@@ -0,0 +1,89 @@
+// Assignment 2a - Programming Interactive 2D Graphics with OpenGL
+// Work by Jacob Secunda
+//
+// Converts a text model ("x y r g b" per vertex, see Model.hpp) into the
+// binary mesh format of MeshFile.hpp, which HW2a maps and uploads directly.
+//
+// Usage: HW2aMeshConverter [--planar] [--vertex-cache | --morton] [--no-lod] input.txt output.hw2m
+//
+// Vertices are written interleaved with RGBA8 colors (12 bytes each), or
+// with --planar as all positions followed by all float colors (20 bytes).
+// Repeated vertices are merged and the mesh is stored indexed, with its
+// vertices in first-use order. Triangles keep the input's order, as HW2a
+// draws a text model, since where they overlap the last one shows;
+// --vertex-cache orders them for the post-transform vertex cache and
+// --morton along a Z-order curve, for models that don't overlap.
+// Levels of detail (see MeshLOD.hpp) are built here, once, and stored as
+// ranges of the index blob, so HW2a can draw them without building them at
+// startup. --no-lod leaves them out.
+
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+
+#include "core/IndexedMesh.hpp"
+#include "core/MeshFile.hpp"
+#include "core/MeshLOD.hpp"
+#include "core/MeshOptimizer.hpp"
+#include "core/Model.hpp"
+#include "core/VertexFormat.hpp"
+
+int
+main(int argc, char* argv[])
+{
+	VertexFormat format = VertexFormat::Packed();
+	MeshOptimizer::Options options;
+	bool buildLevels = true;
+	int argument = 1;
+	for (; argument < argc && strncmp(argv[argument], "--", 2) == 0; argument++) {
+		if (strcmp(argv[argument], "--planar") == 0)
+			format = VertexFormat::Planar();
+		else if (strcmp(argv[argument], "--vertex-cache") == 0)
+			options.triangleOrder = MeshOptimizer::TriangleOrder::kVertexCache;
+		else if (strcmp(argv[argument], "--morton") == 0)
+			options.triangleOrder = MeshOptimizer::TriangleOrder::kMorton;
+		else if (strcmp(argv[argument], "--no-lod") == 0)
+			buildLevels = false;
+		else
+			break;
+	}
+
+	if (argc - argument != 2) {
+		printf("usage: %s [--planar] [--vertex-cache | --morton] [--no-lod] input.txt output.hw2m\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	const char* inputPath = argv[argument];
+	const char* outputPath = argv[argument + 1];
+
+	Model model;
+	if (!LoadTextModelParallel(inputPath, model))
+		return EXIT_FAILURE;
+
+	IndexedMesh mesh = BuildIndexedMesh(model);
+	mesh.PrintReduction(inputPath, format.VertexSize());
+
+	MeshOptimizer::PrintStatistics("before optimizing", MeshOptimizer::Analyze(mesh, format.VertexSize()));
+	MeshOptimizer::Optimize(mesh, options);
+	MeshOptimizer::PrintStatistics("after optimizing", MeshOptimizer::Analyze(mesh, format.VertexSize()));
+
+	// Coarser levels go after the full one in the same index blob
+	std::vector<MeshFile::LevelDescriptor> levels;
+	if (buildLevels) {
+		const std::vector<MeshLOD::Level> meshLevels = MeshLOD::BuildLevels(mesh, options);
+		MeshLOD::PrintLevels(inputPath, meshLevels);
+		levels = MeshLOD::ToDescriptors(meshLevels);
+	}
+
+	const std::vector<std::byte> vertexData = format.Pack(mesh.vertices);
+	const std::vector<MeshFile::AttributeDescriptor> attributes = format.Attributes(mesh.vertices.VertexCount());
+	const std::vector<std::byte> indexData = mesh.PackIndices();
+
+	if (!MeshFile::Write(outputPath, static_cast<uint32_t>(mesh.vertices.VertexCount()), attributes, vertexData,
+			mesh.IndexType(), indexData, levels))
+		return EXIT_FAILURE;
+
+	printf("wrote %zu vertices (%zu bytes each), %zu indices and %zu levels to %s\n", mesh.vertices.VertexCount(),
+		format.VertexSize(), mesh.indices.size(), levels.size(), outputPath);
+	return EXIT_SUCCESS;
+}
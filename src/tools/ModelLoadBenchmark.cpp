@@ -0,0 +1,83 @@
+// Assignment 2a - Programming Interactive 2D Graphics with OpenGL
+// Work by Jacob Secunda
+//
+// Measures how fast text models load (see Model.hpp), in MB/s, for the
+// streaming single-threaded reader and for the parallel reader at 1, 2, 4, ...
+// threads up to the number of hardware threads.
+//
+// Usage: HW2aModelLoadBenchmark model.txt [repetitions]
+
+#include <chrono>
+#include <cstdlib>
+#include <cstdio>
+#include <thread>
+
+#include "core/MappedFile.hpp"
+#include "core/Model.hpp"
+
+// Returns the best time in seconds out of 'repetitions' loads
+template<typename Load>
+static double
+bestLoadTime(int repetitions, Load load)
+{
+	double best = 0;
+	for (int repetition = 0; repetition < repetitions; repetition++) {
+		const auto start = std::chrono::steady_clock::now();
+		if (!load())
+			exit(EXIT_FAILURE);
+		const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+		if (repetition == 0 || elapsed.count() < best)
+			best = elapsed.count();
+	}
+
+	return best;
+}
+
+int
+main(int argc, char* argv[])
+{
+	if (argc < 2 || argc > 3) {
+		printf("usage: %s model.txt [repetitions]\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	const char* path = argv[1];
+	const int repetitions = (argc > 2) ? std::max(1, atoi(argv[2])) : 3;
+
+	// Size the file, and bring it into the page cache so every run measures parsing
+	size_t fileSize = 0;
+	{
+		MappedFile file;
+		if (!file.Open(path))
+			return EXIT_FAILURE;
+
+		fileSize = file.Size();
+
+		// Printed, so the compiler has to keep the reads
+		unsigned checksum = 0;
+		for (size_t offset = 0; offset < file.Size(); offset += 4096)
+			checksum += std::to_integer<unsigned>(file.Data()[offset]);
+
+		printf("paged in %s (checksum %u)\n", path, checksum);
+	}
+
+	const double megabytes = double(fileSize) / (1024 * 1024);
+	Model model;
+
+	const double streamingTime = bestLoadTime(repetitions, [&]() { return LoadTextModel(path, model); });
+	printf("%zu vertices, %.1f MB, best of %d\n", model.VertexCount(), megabytes, repetitions);
+	printf("%-10s %8s %10s %8s\n", "reader", "threads", "MB/s", "speedup");
+	printf("%-10s %8d %10.1f %8.2f\n", "streaming", 1, megabytes / streamingTime, 1.0);
+
+	const unsigned maxThreads = std::max(1u, std::thread::hardware_concurrency());
+	for (unsigned threads = 1; ; threads = std::min(threads * 2, maxThreads)) {
+		const double time = bestLoadTime(repetitions, [&]() { return LoadTextModelParallel(path, model, threads); });
+		printf("%-10s %8u %10.1f %8.2f\n", "parallel", threads, megabytes / time, streamingTime / time);
+
+		if (threads == maxThreads)
+			break;
+	}
+
+	return EXIT_SUCCESS;
+}
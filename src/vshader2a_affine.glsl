@@ -0,0 +1,12 @@
+// vertex shader for 2D affine transforms
+
+#version 150
+in vec4 vertex_position;
+in vec4 vertex_color;
+out vec4 vcolor;
+uniform mat3x2 M; // 2D affine transform, same as the x/y/translation part of a mat4
+
+void main()  {
+	gl_Position = vec4(M*vec3(vertex_position.xy, 1.0), 0.0, 1.0); // update vertex position using M
+	vcolor = vertex_color;  // pass vertex color to fragment shader
+}
\ No newline at end of file
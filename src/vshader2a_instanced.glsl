@@ -0,0 +1,18 @@
+// vertex shader for many copies of a model, drawn with one instanced call
+
+#version 150
+in vec4 vertex_position;
+in vec4 vertex_color;
+out vec4 vcolor;
+uniform mat4 M; // applied to every copy
+uniform samplerBuffer instance_transforms; // 2 texels per copy: mat3x2 columns 0 and 1, then column 2 in xy
+uniform samplerBuffer instance_tints; // 1 texel per copy, multiplies the vertex color
+
+void main()  {
+	vec4 linear = texelFetch(instance_transforms, 2 * gl_InstanceID);
+	vec2 translation = texelFetch(instance_transforms, 2 * gl_InstanceID + 1).xy;
+	mat3x2 instance = mat3x2(linear.xy, linear.zw, translation); // this copy's own 2D affine transform
+
+	gl_Position = M*vec4(instance*vec3(vertex_position.xy, 1.0), 0.0, 1.0); // update vertex position using the copy's transform, then M
+	vcolor = vertex_color*texelFetch(instance_tints, gl_InstanceID);  // pass tinted vertex color to fragment shader
+}
\ No newline at end of file